@@ -2,11 +2,12 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <editor/Application.hpp>
+#include <loader/BinaryEffect.hpp>
+#include <loader/JsonEffect.hpp>
+#include <utils/TextureCache.hpp>
 #include <utils/Utility.hpp>
 #include <SFML/Window/Event.hpp>
-#include <Thor/Math.hpp>
-#include <Thor/Vectors/PolarVector2.hpp>
-#include <Thor/Animations/FadeAnimation.hpp>
+#include <particles/Affectors.hpp>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
@@ -21,22 +22,24 @@ using nlohmann::json;
 
 namespace px
 {
+	namespace
+	{
+		// Keeps a runaway edit from allocating without limit, files can raise it through "maxParticles".
+		// The editor never leaves the count unbounded, the input stays at one or more
+		const int editorMaxParticles = 100000;
+
+		// The preview simulates at this rate whatever the frame time
+		const sf::Time simulationStep = sf::seconds(1.f / 60.f);
+	}
+
 	int Application::m_blendItem = 0;
 	int Application::m_shapeItem = 0;
+	int Application::m_evictionItem = 0;
 	float Application::m_color[] = { 1.f, 1.f, 1.f };
 
-	inline thor::Distribution<sf::Vector2f> scaleDistribution(sf::Vector2f size)
-	{	
-		return [=]() -> sf::Vector2f
-		{
-			auto res = thor::random(size.x, size.y);
-			return sf::Vector2f(res, res);
-		};
-	}
-
 	Application::Application() : m_window(sf::VideoMode(1200U, 800U), "Particle Editor", sf::Style::Close,
 										  sf::ContextSettings(0U, 0U, 8U)), m_particlePath("particle.png"),
-										  m_playing(true)
+										  m_playing(true), m_changedParameters(ParticleLoader::AllParameters)
 	{
 		m_window.setVerticalSyncEnabled(true);
 		ImGui::SFML::Init(m_window);
@@ -45,14 +48,19 @@ namespace px
 		m_particle.fullParticlePath = "src/res/textures/particle.png";
 		m_playButtonTexture.loadFromFile("src/res/textures/icons/play_button.png");
 		m_pauseButtonTexture.loadFromFile("src/res/textures/icons/pause_button.png");
-		m_particle.texture.loadFromFile(m_particle.fullParticlePath);
+		TextureCache::getDefault().setAsyncDecode(true);
+		m_particle.texture = TextureCache::getDefault().acquire(m_particle.fullParticlePath);
 		m_playButton.setTexture(m_playButtonTexture);
 		m_pauseButton.setTexture(m_pauseButtonTexture);
-		m_textureButton.setTexture(m_particle.texture);
-		m_particleSystem.setTexture(m_particle.texture);
+		m_textureButton.setTexture(*m_particle.texture);
+		m_particleSystem.setTexture(*m_particle.texture);
+		m_particleSystem.setThreadPool(&m_threadPool);
+		m_particleSystem.setFixedTimestep(simulationStep);
+		m_particle.maxParticles = editorMaxParticles;
+		applyCapacity();
 
 		// Apply the emitter and start playback time
-		m_emitterConnection = m_particleSystem.addEmitter(thor::refEmitter(m_emitter), sf::seconds(m_particle.duration)); 
+		m_emitterConnection = m_particleSystem.addEmitter(refEmitter(m_emitter), sf::seconds(m_particle.duration)); 
 		m_playbackWatch.start();
 
 		// Supply actions to the action map
@@ -100,37 +108,17 @@ namespace px
 
 	void Application::updateParticles(sf::Time dt)
 	{
-		// Update emitter
-		m_emitter.setEmissionRate(m_particle.nrOfParticles);
-		m_emitter.setParticleLifetime(thor::Distributions::uniform(sf::seconds(m_particle.lifetime.x), sf::seconds(m_particle.lifetime.y)));
-		m_emitter.setParticleScale(scaleDistribution(m_particle.size));
-		m_emitter.setParticleRotation(thor::Distributions::uniform(m_particle.rotation.x, m_particle.rotation.y));
-		m_emitter.setParticleRotationSpeed(thor::Distributions::uniform(m_particle.rotationSpeed.x, m_particle.rotationSpeed.y));
-		m_emitter.setParticleColor(m_particle.color);
-
-		if (m_particle.velocityPolarVector)
-		{
-			if (m_particle.deflect)
-				m_emitter.setParticleVelocity(thor::Distributions::deflect(
-											  thor::PolarVector2f(m_particle.velocity.x, m_particle.velocity.y), m_particle.maxRotation));
-			else
-				m_emitter.setParticleVelocity(thor::PolarVector2f(m_particle.velocity.x, m_particle.velocity.y));
-		}
-		else
+		// Picked and opened textures are decoded in the background, the button takes the size of the arrived image
+		if (TextureCache::getDefault().uploadDecoded() > 0U)
+			m_textureButton.setTexture(*m_particle.texture, true);
+
+		// Only rebuild the distributions whose parameters were edited since the last frame
+		if (m_changedParameters != 0U)
 		{
-			if(m_particle.deflect)
-				m_emitter.setParticleVelocity(thor::Distributions::deflect(m_particle.velocity, m_particle.maxRotation));
-			else
-				m_emitter.setParticleVelocity(m_particle.velocity);
+			ParticleLoader::configureEmitter(m_emitter, m_particle, m_changedParameters);
+			m_changedParameters = 0U;
 		}
 
-		if (m_particle.shape == "Circle")
-			m_emitter.setParticlePosition(thor::Distributions::circle(m_particle.position, m_particle.radius));
-		else if (m_particle.shape == "Rectangle")
-			m_emitter.setParticlePosition(thor::Distributions::rect(m_particle.position, m_particle.halfSize));
-		else
-			m_emitter.setParticlePosition(m_particle.position);
-
 		if(m_playing)
 			m_particleSystem.update(dt);
 	}
@@ -161,7 +149,7 @@ namespace px
 			}
 
 			if (!m_particle.looping && !m_emitterConnection.isConnected()) // Play the emitter once when looping is disabled
-				m_emitterConnection = m_particleSystem.addEmitter(thor::refEmitter(m_emitter), sf::seconds(m_particle.duration));
+				m_emitterConnection = m_particleSystem.addEmitter(refEmitter(m_emitter), sf::seconds(m_particle.duration));
 		}
 		ImGui::SameLine();
 		if (ImGui::ImageButton(m_pauseButton, sf::Vector2f(20.f, 25.f), 1, sf::Color::Black))
@@ -229,19 +217,48 @@ namespace px
 				ImGui::EndTooltip();
 			}
 			ImGui::Spacing();
+			ImGui::Checkbox("Prewarm", &m_particle.prewarm);
+			ImGui::SameLine();
+			ImGui::TextDisabled("(?)");
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::BeginTooltip();
+				ImGui::SetTooltip("Loaded looping systems start out filled\nwith particles instead of empty");
+				ImGui::EndTooltip();
+			}
+			ImGui::Spacing();
 			ImGui::InputFloat("Duration", &m_particle.duration, 0.1f);
 			ImGui::Spacing();
-			ImGui::InputFloat("Particles", &m_particle.nrOfParticles, 1.f);
+			if (ImGui::InputFloat("Particles", &m_particle.nrOfParticles, 1.f))
+				m_changedParameters |= ParticleLoader::EmissionRate;
 			ImGui::Spacing();
-			ImGui::InputFloat2("Position", &m_particle.position.x, floatPrecision);
+			if (ImGui::InputInt("Max particles", &m_particle.maxParticles, 100))
+			{
+				m_particle.maxParticles = std::max(m_particle.maxParticles, 1);
+				applyCapacity();
+			}
 			ImGui::Spacing();
-			ImGui::InputFloat2("Size", &m_particle.size.x, floatPrecision);
+			const char* evictionList[] = { "DropNew", "KillOldest", "KillNearestToDeath" };
+			if (ImGui::Combo("When full", &m_evictionItem, evictionList, IM_ARRAYSIZE(evictionList)))
+			{
+				m_particle.eviction = evictionList[m_evictionItem];
+				applyCapacity();
+			}
+			ImGui::Spacing();
+			if (ImGui::InputFloat2("Position", &m_particle.position.x, floatPrecision))
+				m_changedParameters |= ParticleLoader::Position;
+			ImGui::Spacing();
+			if (ImGui::InputFloat2("Size", &m_particle.size.x, floatPrecision))
+				m_changedParameters |= ParticleLoader::Scale;
 			ImGui::Spacing();
-			ImGui::InputFloat2("Rotation", &m_particle.rotation.x, floatPrecision);
+			if (ImGui::InputFloat2("Rotation", &m_particle.rotation.x, floatPrecision))
+				m_changedParameters |= ParticleLoader::Rotation;
 			ImGui::Spacing();
-			ImGui::InputFloat2("Rotation Speed", &m_particle.rotationSpeed.x, floatPrecision);
+			if (ImGui::InputFloat2("Rotation Speed", &m_particle.rotationSpeed.x, floatPrecision))
+				m_changedParameters |= ParticleLoader::RotationSpeed;
 			ImGui::Spacing();
-			ImGui::InputFloat2("Lifetime", &m_particle.lifetime.x, floatPrecision);
+			if (ImGui::InputFloat2("Lifetime", &m_particle.lifetime.x, floatPrecision))
+				m_changedParameters |= ParticleLoader::Lifetime;
 			ImGui::Spacing();
 
 			if (ImGui::ColorEdit3("Color", m_color))
@@ -249,6 +266,7 @@ namespace px
 				m_particle.color.r = static_cast<sf::Uint8>(m_color[0] * 255.f);
 				m_particle.color.g = static_cast<sf::Uint8>(m_color[1] * 255.f);
 				m_particle.color.b = static_cast<sf::Uint8>(m_color[2] * 255.f);
+				m_changedParameters |= ParticleLoader::Color;
 			}
 			ImGui::Spacing();
 
@@ -268,8 +286,7 @@ namespace px
 					if (m_fadeConnection.isConnected())
 						m_fadeConnection.disconnect();
 
-					thor::FadeAnimation fader(m_particle.fader.x, m_particle.fader.y);
-					m_fadeConnection = m_particleSystem.addAffector(thor::AnimationAffector(fader));
+					m_fadeConnection = m_particleSystem.addAffector(FadeAffector(m_particle.fader.x, m_particle.fader.y));
 				}
 				ImGui::SameLine();
 				ImGui::TextDisabled("(?)");
@@ -287,10 +304,14 @@ namespace px
 			if (ImGui::CollapsingHeader("Velocity over Lifetime"))
 			{
 				ImGui::Spacing();
-				ImGui::Checkbox("Deflect", &m_particle.deflect);
+				if (ImGui::Checkbox("Deflect", &m_particle.deflect))
+					m_changedParameters |= ParticleLoader::Velocity;
 				ImGui::Spacing();
 				if (ImGui::Checkbox("Use Polar Vector", &m_particle.velocityPolarVector))
+				{
 					m_particle.velocity = sf::Vector2f(0.f, 0.f);
+					m_changedParameters |= ParticleLoader::Velocity;
+				}
 				ImGui::SameLine();
 				ImGui::TextDisabled("(?)");
 				if (ImGui::IsItemHovered())
@@ -300,12 +321,14 @@ namespace px
 					ImGui::EndTooltip();
 				}
 				ImGui::Spacing();
-				ImGui::InputFloat2("Velocity", &m_particle.velocity.x, floatPrecision);
+				if (ImGui::InputFloat2("Velocity", &m_particle.velocity.x, floatPrecision))
+					m_changedParameters |= ParticleLoader::Velocity;
 				ImGui::Spacing();
 
 				if (m_particle.deflect)
 				{
-					ImGui::InputFloat("Max rotation", &m_particle.maxRotation, 1.f);
+					if (ImGui::InputFloat("Max rotation", &m_particle.maxRotation, 1.f))
+						m_changedParameters |= ParticleLoader::Velocity;
 					ImGui::Spacing();
 				}
 			}
@@ -321,7 +344,7 @@ namespace px
 					if (m_forceConnection.isConnected())
 						m_forceConnection.disconnect();
 
-					m_forceConnection = m_particleSystem.addAffector(thor::ForceAffector(m_particle.force));
+					m_forceConnection = m_particleSystem.addAffector(ForceAffector(m_particle.force));
 				}
 				ImGui::Spacing();
 			}
@@ -337,7 +360,7 @@ namespace px
 					if (m_torqueConnection.isConnected())
 						m_torqueConnection.disconnect();
 
-					m_torqueConnection = m_particleSystem.addAffector(thor::TorqueAffector(m_particle.torque));
+					m_torqueConnection = m_particleSystem.addAffector(TorqueAffector(m_particle.torque));
 				}
 				ImGui::Spacing();
 			}
@@ -348,24 +371,26 @@ namespace px
 			{
 				ImGui::Spacing();
 				const char* itemList[] = { "None", "Circle", "Rectangle" };
-				ImGui::Combo("Shape##1", &m_shapeItem, itemList, IM_ARRAYSIZE(itemList));
+				if (ImGui::Combo("Shape##1", &m_shapeItem, itemList, IM_ARRAYSIZE(itemList)))
+				{
+					m_particle.shape = itemList[m_shapeItem];
+					m_changedParameters |= ParticleLoader::Position;
+				}
 
 				if (m_shapeItem == 1)
 				{
-					m_particle.shape = "Circle";
 					ImGui::Spacing();
-					ImGui::InputFloat("Radius", &m_particle.radius, 1.f);
+					if (ImGui::InputFloat("Radius", &m_particle.radius, 1.f))
+						m_changedParameters |= ParticleLoader::Position;
 					ImGui::Spacing();
 				}
 				else if (m_shapeItem == 2)
 				{
-					m_particle.shape = "Rectangle";
 					ImGui::Spacing();
-					ImGui::InputFloat2("Half size", &m_particle.halfSize.x, floatPrecision);
+					if (ImGui::InputFloat2("Half size", &m_particle.halfSize.x, floatPrecision))
+						m_changedParameters |= ParticleLoader::Position;
 					ImGui::Spacing();
 				}
-				else
-					m_particle.shape = "None";
 			}
 			ImGui::Spacing();
 
@@ -395,15 +420,19 @@ namespace px
 					break;
 				}
 
+				ImGui::Spacing();
+				if (ImGui::Checkbox("Stable order", &m_particle.stableOrder))
+					m_particleSystem.setRemovalMode(ParticleLoader::toRemovalMode(m_particle.stableOrder));
+
 				ImGui::Spacing();
 				ImGui::Separator();
 				ImGui::Spacing();
 				if (ImGui::ImageButton(m_textureButton, sf::Vector2f(100.f, 100.f), -1, sf::Color::Black, m_particle.color))
 				{
 					openTextureFile(m_particle.fullParticlePath, m_particlePath);
-					m_particle.texture.loadFromFile(m_particle.fullParticlePath);
-					m_particleSystem.setTexture(m_particle.texture);
-					m_textureButton.setTexture(m_particle.texture);
+					m_particle.texture = TextureCache::getDefault().acquire(m_particle.fullParticlePath);
+					m_particleSystem.setTexture(*m_particle.texture);
+					m_textureButton.setTexture(*m_particle.texture);
 				}
 				ImGui::Text(m_particlePath.c_str());
 				ImGui::Spacing();
@@ -429,7 +458,7 @@ namespace px
 		utils::constrainDistrVec(m_particle.size);
 
 		if (!m_emitterConnection.isConnected() && m_particle.looping)
-			m_emitterConnection = m_particleSystem.addEmitter(thor::refEmitter(m_emitter), sf::seconds(m_particle.duration));
+			m_emitterConnection = m_particleSystem.addEmitter(refEmitter(m_emitter), sf::seconds(m_particle.duration));
 	}
 
 	void Application::render()
@@ -477,7 +506,7 @@ namespace px
 	void Application::openParticleFile()
 	{
 		nfdchar_t* outPath = NULL;
-		nfdresult_t result = NFD_OpenDialog("json", NULL, &outPath);
+		nfdresult_t result = NFD_OpenDialog("json,pxb", NULL, &outPath);
 
 		if (result == NFD_OKAY)
 		{
@@ -496,18 +525,23 @@ namespace px
 	void Application::saveParticleFile()
 	{
 		nfdchar_t *savePath = NULL;
-		nfdresult_t result = NFD_SaveDialog("json", NULL, &savePath);
+		nfdresult_t result = NFD_SaveDialog("json,pxb", NULL, &savePath);
 
 		if (result == NFD_OKAY)
 		{
 			std::string filePath = savePath;
 			std::replace(filePath.begin(), filePath.end(), '\\', '/');
 
-			// Add .json as the file format if missing
-			if (filePath.find(".json") == std::string::npos)
-				filePath.append(".json");
+			// Compiled effects keep their extension, anything else is saved as .json
+			if (BinaryEffect::isBinaryFile(filePath))
+				outputBinaryParticleData(filePath);
+			else
+			{
+				if (filePath.find(".json") == std::string::npos)
+					filePath.append(".json");
 
-			outputParticleData(filePath);
+				outputParticleData(filePath);
+			}
 			printf("Saved file to: %s\n", savePath);
 			free(savePath);
 		}
@@ -517,57 +551,44 @@ namespace px
 			printf("Error: %s\n", NFD_GetError());
 	}
 
-	// Load particle data from json file
+	// Load particle data from a json or compiled effect file
 	void Application::loadParticleData(const std::string & filePath)
 	{
-		std::ifstream i(filePath);
-		json data;
-		i >> data;
-		i.close();
-				
-		// Data
-		m_particle.fullParticlePath = data["texture"].get<std::string>();
-		m_particle.looping = data["looping"].get<bool>();
-		m_particle.deflect = data["deflect"].get<bool>();
-		m_particle.enableTorqueAff = data["enableTorqueAff"].get<bool>();
-		m_particle.enableFadeAff = data["enableFadeAff"].get<bool>();
-		m_particle.enableForceAff = data["enableForceAff"].get<bool>();
-		m_particle.velocityPolarVector = data["velPolarVector"].get<bool>();
-		m_particle.duration = data["duration"].get<float>();
-		m_particle.radius = data["circleRadius"].get<float>();
-		m_particle.nrOfParticles = data["particles"].get<float>();
-		m_particle.torque = data["torque"].get<float>();
-		m_particle.maxRotation = data["maxRotation"].get<float>();
-		m_particle.rotationSpeed = sf::Vector2f(data["rotationSpeed"][0].get<float>(), data["rotationSpeed"][1].get<float>());
-		m_particle.rotation = sf::Vector2f(data["rotation"][0].get<float>(), data["rotation"][1].get<float>());
-		m_particle.lifetime = sf::Vector2f(data["lifetime"][0].get<float>(), data["lifetime"][1].get<float>());
-		m_particle.halfSize = sf::Vector2f(data["rectHalfSize"][0].get<float>(), data["rectHalfSize"][1].get<float>());
-		m_particle.position = sf::Vector2f(data["position"][0].get<float>(), data["position"][1].get<float>());
-		m_particle.size = sf::Vector2f(data["size"][0].get<float>(), data["size"][1].get<float>());
-		m_particle.velocity = sf::Vector2f(data["velocity"][0].get<float>(), data["velocity"][1].get<float>());
-		m_particle.fader = sf::Vector2f(data["fader"][0].get<float>(), data["fader"][1].get<float>());
-		m_particle.force = sf::Vector2f(data["force"][0].get<float>(), data["force"][1].get<float>());
-		m_particle.color = sf::Color(data["color"][0].get<sf::Uint8>(), data["color"][1].get<sf::Uint8>(), 
-								     data["color"][2].get<sf::Uint8>(), data["color"][3].get<sf::Uint8>());
-		m_blendItem = data["blendMode"].get<int>();
-		m_shapeItem = data["shapeItem"].get<int>();
-		m_particle.shape = data["shape"].get<std::string>();
+		// Optional keys of older files fall back to the editor's defaults
+		ParticleLoader::Properties properties;
+		properties.maxParticles = editorMaxParticles;
+		if (!(BinaryEffect::isBinaryFile(filePath) ? BinaryEffect::load(filePath, properties) : JsonEffect::load(filePath, properties)))
+		{
+			printf("Error: %s is not a valid effect file\n", filePath.c_str());
+			return;
+		}
+
+		m_particle = properties;
+		if (m_particle.maxParticles <= 0)
+			m_particle.maxParticles = editorMaxParticles;
+		m_blendItem = ParticleLoader::toBlendItem(m_particle.blendMode);
+		m_shapeItem = static_cast<int>(ParticleLoader::toShape(m_particle.shape));
+		m_particleSystem.setRemovalMode(ParticleLoader::toRemovalMode(m_particle.stableOrder));
+		m_evictionItem = static_cast<int>(ParticleLoader::toEvictionPolicy(m_particle.eviction));
+		applyCapacity();
 
 		// Affectors
 		if (m_particle.enableTorqueAff)
-			m_torqueConnection = m_particleSystem.addAffector(thor::TorqueAffector(m_particle.torque));
+			m_torqueConnection = m_particleSystem.addAffector(TorqueAffector(m_particle.torque));
 		if (m_particle.enableForceAff)
-			m_forceConnection = m_particleSystem.addAffector(thor::ForceAffector(m_particle.force));
+			m_forceConnection = m_particleSystem.addAffector(ForceAffector(m_particle.force));
 		if (m_particle.enableFadeAff)
 		{
-			thor::FadeAnimation fader(m_particle.fader.x, m_particle.fader.y);
-			m_fadeConnection = m_particleSystem.addAffector(thor::AnimationAffector(fader));
+			m_fadeConnection = m_particleSystem.addAffector(FadeAffector(m_particle.fader.x, m_particle.fader.y));
 		}
 
+		m_emitter.seed(m_particle.seed != 0U ? m_particle.seed : makeSeed());
+		m_changedParameters = ParticleLoader::AllParameters;
+
 		// Set texture
-		m_particle.texture.loadFromFile(m_particle.fullParticlePath);
-		m_particleSystem.setTexture(m_particle.texture);
-		m_textureButton.setTexture(m_particle.texture);
+		m_particle.texture = TextureCache::getDefault().acquire(m_particle.fullParticlePath);
+		m_particleSystem.setTexture(*m_particle.texture);
+		m_textureButton.setTexture(*m_particle.texture);
 		m_color[0] = static_cast<float>(static_cast<float>(m_particle.color.r) / 255.f);
 		m_color[1] = static_cast<float>(static_cast<float>(m_particle.color.g) / 255.f);
 		m_color[2] = static_cast<float>(static_cast<float>(m_particle.color.b) / 255.f);
@@ -576,22 +597,19 @@ namespace px
 	// Write particle data to json file
 	void Application::outputParticleData(const std::string & filePath)
 	{
-		auto enableFloat = [](const float & value) -> bool { return value == 0.f ? false : true; };
-		auto enableVec = [](const sf::Vector2f & vec) -> bool { return vec == sf::Vector2f(0.f, 0.f) ? false : true; };
-
-		m_particle.enableTorqueAff = enableFloat(m_particle.torque);
-		m_particle.enableFadeAff = enableVec(m_particle.fader);
-		m_particle.enableForceAff = enableVec(m_particle.force);
+		updateAffectorFlags();
 
 		// Data
 		json data = {
 			{ "texture", m_particle.fullParticlePath },
 			{ "looping", m_particle.looping },
+			{ "prewarm", m_particle.prewarm },
 			{ "deflect", m_particle.deflect },
 			{ "velPolarVector", m_particle.velocityPolarVector },
 			{ "enableTorqueAff", m_particle.enableTorqueAff },
 			{ "enableFadeAff", m_particle.enableFadeAff },
 			{ "enableForceAff", m_particle.enableForceAff },
+			{ "seed", m_particle.seed },
 			{ "duration", m_particle.duration },
 			{ "circleRadius",  m_particle.radius},
 			{ "particles", m_particle.nrOfParticles },
@@ -609,6 +627,9 @@ namespace px
 			{ "color", { m_particle.color.r, m_particle.color.g, m_particle.color.b, m_particle.color.a } },
 			{ "force", { m_particle.force.x, m_particle.force.y } },
 			{ "blendMode", m_blendItem },
+			{ "stableOrder", m_particle.stableOrder },
+			{ "maxParticles", m_particle.maxParticles },
+			{ "eviction", m_particle.eviction },
 			{ "shapeItem", m_shapeItem },
 			{ "shape", m_particle.shape },
 		};
@@ -616,4 +637,30 @@ namespace px
 		std::ofstream o(filePath);
 		o << std::setw(4) << data << std::endl;
 	}
+
+	// Write particle data to a compiled effect file, the editor's shape and blend items are derived on loading
+	void Application::outputBinaryParticleData(const std::string & filePath)
+	{
+		updateAffectorFlags();
+
+		if (!BinaryEffect::save(filePath, m_particle))
+			printf("Error: could not write %s\n", filePath.c_str());
+	}
+
+	// Affectors without any effect are not stored as enabled
+	void Application::updateAffectorFlags()
+	{
+		auto enableFloat = [](const float & value) -> bool { return value == 0.f ? false : true; };
+		auto enableVec = [](const sf::Vector2f & vec) -> bool { return vec == sf::Vector2f(0.f, 0.f) ? false : true; };
+
+		m_particle.enableTorqueAff = enableFloat(m_particle.torque);
+		m_particle.enableFadeAff = enableVec(m_particle.fader);
+		m_particle.enableForceAff = enableVec(m_particle.force);
+	}
+
+	void Application::applyCapacity()
+	{
+		m_particleSystem.setCapacity(static_cast<std::size_t>(m_particle.maxParticles),
+			ParticleLoader::toEvictionPolicy(m_particle.eviction));
+	}
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics.hpp>
 #include <loader/ParticleLoader.hpp>
+#include <utils/ThreadPool.hpp>
 #include <Thor/Time/StopWatch.hpp>
 #include <Thor/Input/ActionMap.hpp>
 
@@ -30,6 +31,9 @@ namespace px
 		void saveParticleFile();
 		void loadParticleData(const std::string & filePath);
 		void outputParticleData(const std::string & filePath);
+		void outputBinaryParticleData(const std::string & filePath);
+		void updateAffectorFlags();
+		void applyCapacity();
 
 	private:
 		sf::RenderWindow m_window;
@@ -37,14 +41,17 @@ namespace px
 		sf::Texture m_playButtonTexture, m_pauseButtonTexture;
 		sf::Sprite m_textureButton, m_playButton, m_pauseButton;
 		bool m_playing;
+		unsigned int m_changedParameters;
 		static int m_shapeItem;
 		static int m_blendItem;
+		static int m_evictionItem;
 		static float m_color[3];
 
 	private:
 		ParticleLoader::Properties m_particle;
-		thor::ParticleSystem m_particleSystem;
-		thor::UniversalEmitter m_emitter;
+		ThreadPool m_threadPool;
+		ParticleSystem m_particleSystem;
+		UniversalEmitter m_emitter;
 		thor::Connection m_emitterConnection;
 		thor::Connection m_fadeConnection;
 		thor::Connection m_torqueConnection;
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "BinaryEffect.hpp"
+#include <utils/MappedFile.hpp>
+#include <cstring>
+#include <fstream>
+
+namespace px
+{
+	namespace BinaryEffect
+	{
+		namespace
+		{
+			const char magic[4] = { 'P', 'X', 'B', 'F' };
+			const char* shapeNames[] = { "None", "Circle", "Rectangle" };
+			const char* evictionNames[] = { "DropNew", "KillOldest", "KillNearestToDeath" };
+
+			template <std::size_t N>
+			const char* toName(const char* (&names)[N], std::int32_t index)
+			{
+				return index >= 0 && static_cast<std::size_t>(index) < N ? names[index] : names[0];
+			}
+
+			sf::Vector2f toVector(const float (&value)[2])
+			{
+				return sf::Vector2f(value[0], value[1]);
+			}
+
+			void fromVector(float (&value)[2], const sf::Vector2f & vector)
+			{
+				value[0] = vector.x;
+				value[1] = vector.y;
+			}
+		}
+
+		bool isBinaryFile(const std::string & filePath)
+		{
+			const std::size_t length = sizeof(fileExtension) - 1U;
+			return filePath.size() >= length && filePath.compare(filePath.size() - length, length, fileExtension) == 0;
+		}
+
+		bool read(const char * data, std::size_t size, EffectDefinition::Properties & properties)
+		{
+			// Copied out, the record may not be aligned within the data
+			Record record;
+			if (size < sizeof(Record))
+				return false;
+
+			std::memcpy(&record, data, sizeof(Record));
+			if (std::memcmp(record.magic, magic, sizeof(magic)) != 0 || record.version != currentVersion ||
+				record.textureLength > size - sizeof(Record))
+				return false;
+
+			properties.looping = (record.flags & Looping) != 0U;
+			properties.prewarm = (record.flags & Prewarm) != 0U;
+			properties.deflect = (record.flags & Deflect) != 0U;
+			properties.velocityPolarVector = (record.flags & VelocityPolarVector) != 0U;
+			properties.enableTorqueAff = (record.flags & EnableTorqueAff) != 0U;
+			properties.enableFadeAff = (record.flags & EnableFadeAff) != 0U;
+			properties.enableForceAff = (record.flags & EnableForceAff) != 0U;
+			properties.stableOrder = (record.flags & StableOrder) != 0U;
+			properties.seed = record.seed;
+			properties.maxParticles = record.maxParticles;
+			properties.duration = record.duration;
+			properties.radius = record.radius;
+			properties.nrOfParticles = record.nrOfParticles;
+			properties.torque = record.torque;
+			properties.maxRotation = record.maxRotation;
+			properties.rotationSpeed = toVector(record.rotationSpeed);
+			properties.rotation = toVector(record.rotation);
+			properties.lifetime = toVector(record.lifetime);
+			properties.halfSize = toVector(record.halfSize);
+			properties.position = toVector(record.position);
+			properties.size = toVector(record.size);
+			properties.velocity = toVector(record.velocity);
+			properties.fader = toVector(record.fader);
+			properties.force = toVector(record.force);
+			properties.color = sf::Color(record.color[0], record.color[1], record.color[2], record.color[3]);
+			properties.blendMode = EffectDefinition::toBlendMode(record.blendMode);
+			properties.shape = toName(shapeNames, record.shape);
+			properties.eviction = toName(evictionNames, record.eviction);
+			properties.fullParticlePath.assign(data + sizeof(Record), record.textureLength);
+			return true;
+		}
+
+		bool load(const std::string & filePath, EffectDefinition::Properties & properties)
+		{
+			MappedFile file;
+			return file.open(filePath) && read(file.getData(), file.getSize(), properties);
+		}
+
+		bool save(const std::string & filePath, const EffectDefinition::Properties & properties)
+		{
+			Record record = {};
+			std::memcpy(record.magic, magic, sizeof(magic));
+			record.version = currentVersion;
+			record.flags = (properties.looping ? Looping : 0U) | (properties.prewarm ? Prewarm : 0U) |
+				(properties.deflect ? Deflect : 0U) | (properties.velocityPolarVector ? VelocityPolarVector : 0U) |
+				(properties.enableTorqueAff ? EnableTorqueAff : 0U) | (properties.enableFadeAff ? EnableFadeAff : 0U) |
+				(properties.enableForceAff ? EnableForceAff : 0U) | (properties.stableOrder ? StableOrder : 0U);
+			record.seed = properties.seed;
+			record.maxParticles = properties.maxParticles;
+			record.blendMode = EffectDefinition::toBlendItem(properties.blendMode);
+			record.shape = static_cast<std::int32_t>(EffectDefinition::toShape(properties.shape));
+			record.eviction = static_cast<std::int32_t>(EffectDefinition::toEvictionPolicy(properties.eviction));
+			record.duration = properties.duration;
+			record.radius = properties.radius;
+			record.nrOfParticles = properties.nrOfParticles;
+			record.torque = properties.torque;
+			record.maxRotation = properties.maxRotation;
+			fromVector(record.rotationSpeed, properties.rotationSpeed);
+			fromVector(record.rotation, properties.rotation);
+			fromVector(record.lifetime, properties.lifetime);
+			fromVector(record.halfSize, properties.halfSize);
+			fromVector(record.position, properties.position);
+			fromVector(record.size, properties.size);
+			fromVector(record.velocity, properties.velocity);
+			fromVector(record.fader, properties.fader);
+			fromVector(record.force, properties.force);
+			record.color[0] = properties.color.r;
+			record.color[1] = properties.color.g;
+			record.color[2] = properties.color.b;
+			record.color[3] = properties.color.a;
+			record.textureLength = static_cast<std::uint32_t>(properties.fullParticlePath.size());
+
+			std::ofstream o(filePath, std::ios::binary);
+			o.write(reinterpret_cast<const char*>(&record), sizeof(Record));
+			o.write(properties.fullParticlePath.data(), properties.fullParticlePath.size());
+			return static_cast<bool>(o);
+		}
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <loader/EffectDefinition.hpp>
+#include <cstdint>
+#include <type_traits>
+
+namespace px
+{
+	// Compiled effect files (.pxb). A file is one fixed-layout Record followed by the texture path,
+	// textureLength bytes without a terminator. Fields are in native byte order, so files only move between
+	// hosts of the same endianness. Loading maps the file and copies the record out, nothing is parsed
+	namespace BinaryEffect
+	{
+		const char fileExtension[] = ".pxb";
+		const std::uint32_t currentVersion = 1U;
+
+		enum Flags : std::uint32_t
+		{
+			Looping = 1U << 0,
+			Prewarm = 1U << 1,
+			Deflect = 1U << 2,
+			VelocityPolarVector = 1U << 3,
+			EnableTorqueAff = 1U << 4,
+			EnableFadeAff = 1U << 5,
+			EnableForceAff = 1U << 6,
+			StableOrder = 1U << 7
+		};
+
+		// Enums are stored as their index: the editor's blend mode items, px::EmitterShape and px::EvictionPolicy
+		struct Record
+		{
+			char magic[4];
+			std::uint32_t version;
+			std::uint32_t flags;
+			std::uint32_t seed;
+			std::int32_t maxParticles;
+			std::int32_t blendMode;
+			std::int32_t shape;
+			std::int32_t eviction;
+			float duration;
+			float radius;
+			float nrOfParticles;
+			float torque;
+			float maxRotation;
+			float rotationSpeed[2];
+			float rotation[2];
+			float lifetime[2];
+			float halfSize[2];
+			float position[2];
+			float size[2];
+			float velocity[2];
+			float fader[2];
+			float force[2];
+			std::uint8_t color[4];
+			std::uint32_t textureLength;
+		};
+
+		static_assert(std::is_trivially_copyable<Record>::value && sizeof(Record) == 132U, "Record layout changed");
+
+		bool isBinaryFile(const std::string & filePath);
+
+		// Fill properties from the contents of a .pxb file. Fails for other files and unknown versions,
+		// properties is left untouched then. The texture is not loaded
+		bool read(const char * data, std::size_t size, EffectDefinition::Properties & properties);
+		bool load(const std::string & filePath, EffectDefinition::Properties & properties);
+
+		bool save(const std::string & filePath, const EffectDefinition::Properties & properties);
+	}
+}
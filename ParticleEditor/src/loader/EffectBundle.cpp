@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "EffectBundle.hpp"
+#include <loader/BinaryEffect.hpp>
+#include <loader/JsonEffect.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_set>
+
+namespace px
+{
+	namespace
+	{
+		const char magic[4] = { 'P', 'X', 'P', 'K' };
+
+		struct PackedFile
+		{
+			std::string name;
+			std::vector<char> contents;
+		};
+
+		// Copied out, the entries may not be aligned within the data
+		EffectBundle::Entry readEntry(const char * data, std::size_t index)
+		{
+			EffectBundle::Entry entry;
+			std::memcpy(&entry, data + sizeof(EffectBundle::Header) + index * sizeof(EffectBundle::Entry), sizeof(EffectBundle::Entry));
+			return entry;
+		}
+
+		bool readFile(const std::string & filePath, std::vector<char> & contents)
+		{
+			std::ifstream i(filePath, std::ios::binary | std::ios::ate);
+			if (!i)
+				return false;
+
+			contents.resize(static_cast<std::size_t>(i.tellg()));
+			i.seekg(0);
+			i.read(contents.data(), contents.size());
+			return static_cast<bool>(i);
+		}
+
+		bool readProperties(const std::string & name, const char * data, std::size_t size, EffectDefinition::Properties & properties)
+		{
+			return BinaryEffect::isBinaryFile(name) ? BinaryEffect::read(data, size, properties) : JsonEffect::read(data, size, properties);
+		}
+	}
+
+	EffectBundle::EffectBundle(TextureCache & textures) : m_header(), m_textures(textures)
+	{
+	}
+
+	bool EffectBundle::open(const std::string & filePath)
+	{
+		close();
+		if (!m_file.open(filePath) || m_file.getSize() < sizeof(Header))
+		{
+			close();
+			return false;
+		}
+
+		std::memcpy(&m_header, m_file.getData(), sizeof(Header));
+		const std::uint64_t size = m_file.getSize();
+		const std::uint64_t entryCount = std::uint64_t(m_header.effectCount) + m_header.textureCount;
+		if (std::memcmp(m_header.magic, magic, sizeof(magic)) != 0 || m_header.version != currentVersion ||
+			sizeof(Header) + entryCount * sizeof(Entry) > size)
+		{
+			close();
+			return false;
+		}
+
+		// Only the index is touched, the pages of the files are not read until an effect is loaded
+		for (std::size_t i = 0; i < entryCount; ++i)
+		{
+			const Entry entry = readEntry(m_file.getData(), i);
+			if (std::uint64_t(entry.nameOffset) + entry.nameLength > size || std::uint64_t(entry.dataOffset) + entry.dataSize > size)
+			{
+				close();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void EffectBundle::close()
+	{
+		m_file.close();
+		m_header = Header();
+	}
+
+	bool EffectBundle::contains(const std::string & name) const
+	{
+		std::size_t size = 0U;
+		return find(0U, m_header.effectCount, name, size) != nullptr;
+	}
+
+	std::size_t EffectBundle::getEffectCount() const
+	{
+		return m_header.effectCount;
+	}
+
+	std::shared_ptr<const EffectDefinition> EffectBundle::load(const std::string & name) const
+	{
+		std::size_t size = 0U;
+		const char * data = find(0U, m_header.effectCount, name, size);
+
+		EffectDefinition::Properties properties;
+		if (!data || !readProperties(name, data, size, properties))
+			return nullptr;
+
+		// A texture that is cached already is not decoded again, wherever it came from
+		std::size_t textureSize = 0U;
+		const char * texture = find(m_header.effectCount, m_header.textureCount, properties.fullParticlePath, textureSize);
+		properties.texture = texture ? m_textures.acquire(properties.fullParticlePath, texture, textureSize) :
+			m_textures.acquire(properties.fullParticlePath);
+
+		return std::make_shared<const EffectDefinition>(std::move(properties));
+	}
+
+	bool EffectBundle::save(const std::string & filePath, const std::vector<std::string> & effectPaths)
+	{
+		std::vector<PackedFile> effects;
+		std::vector<PackedFile> textures;
+		std::unordered_set<std::string> effectNames;
+		std::unordered_set<std::string> textureNames;
+
+		for (const auto & effectPath : effectPaths)
+		{
+			if (!effectNames.insert(effectPath).second)
+				continue;
+
+			PackedFile effect{ effectPath, {} };
+			EffectDefinition::Properties properties;
+			if (!readFile(effectPath, effect.contents) ||
+				!readProperties(effectPath, effect.contents.data(), effect.contents.size(), properties))
+				return false;
+
+			PackedFile texture{ properties.fullParticlePath, {} };
+			if (textureNames.insert(texture.name).second && readFile(texture.name, texture.contents))
+				textures.push_back(std::move(texture));
+
+			effects.push_back(std::move(effect));
+		}
+
+		// Same order as the comparisons of find
+		const auto byName = [](const PackedFile & a, const PackedFile & b) { return a.name < b.name; };
+		std::sort(effects.begin(), effects.end(), byName);
+		std::sort(textures.begin(), textures.end(), byName);
+
+		std::vector<const PackedFile*> files;
+		for (const auto & effect : effects)
+			files.push_back(&effect);
+		for (const auto & texture : textures)
+			files.push_back(&texture);
+
+		// Names follow the index so that lookups stay within its first pages, the contents come last
+		std::vector<Entry> entries(files.size());
+		std::uint64_t offset = sizeof(Header) + files.size() * sizeof(Entry);
+		for (std::size_t i = 0; i < files.size(); ++i)
+		{
+			entries[i].nameOffset = static_cast<std::uint32_t>(offset);
+			entries[i].nameLength = static_cast<std::uint32_t>(files[i]->name.size());
+			offset += files[i]->name.size();
+		}
+		for (std::size_t i = 0; i < files.size(); ++i)
+		{
+			entries[i].dataOffset = static_cast<std::uint32_t>(offset);
+			entries[i].dataSize = static_cast<std::uint32_t>(files[i]->contents.size());
+			offset += files[i]->contents.size();
+		}
+
+		if (offset > std::numeric_limits<std::uint32_t>::max())
+			return false;
+
+		Header header = {};
+		std::memcpy(header.magic, magic, sizeof(magic));
+		header.version = currentVersion;
+		header.effectCount = static_cast<std::uint32_t>(effects.size());
+		header.textureCount = static_cast<std::uint32_t>(textures.size());
+
+		std::ofstream o(filePath, std::ios::binary);
+		o.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		o.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+		for (const auto file : files)
+			o.write(file->name.data(), file->name.size());
+		for (const auto file : files)
+			o.write(file->contents.data(), file->contents.size());
+		return static_cast<bool>(o);
+	}
+
+	const char * EffectBundle::find(std::size_t first, std::size_t count, const std::string & name, std::size_t & size) const
+	{
+		const char * data = m_file.getData();
+		std::size_t low = first;
+		std::size_t high = first + count;
+
+		while (low < high)
+		{
+			const std::size_t middle = low + (high - low) / 2U;
+			const Entry entry = readEntry(data, middle);
+			const int order = name.compare(0, name.size(), data + entry.nameOffset, entry.nameLength);
+
+			if (order == 0)
+			{
+				size = entry.dataSize;
+				return data + entry.dataOffset;
+			}
+			else if (order < 0)
+				high = middle;
+			else
+				low = middle + 1U;
+		}
+
+		return nullptr;
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <loader/EffectDefinition.hpp>
+#include <utils/MappedFile.hpp>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace px
+{
+	// Many effect files and their textures packed into one file (.pxpak), so that starting up opens a single
+	// file instead of scanning directories. Effects are found by the path they were packed from. Opening a
+	// bundle only checks its index, an effect is read from the mapping when it is loaded
+	//
+	// Layout: a Header, effectCount Entries sorted by name, textureCount Entries sorted by texture path,
+	// then the names and the contents of the files. Offsets count from the start of the bundle, fields are in
+	// native byte order like those of .pxb files
+	class EffectBundle : private sf::NonCopyable
+	{
+	public:
+		struct Header
+		{
+			char magic[4];
+			std::uint32_t version;
+			std::uint32_t effectCount;
+			std::uint32_t textureCount;
+		};
+
+		// The contents of an effect file as it was packed, .pxb or JSON, or of a texture file
+		struct Entry
+		{
+			std::uint32_t nameOffset;
+			std::uint32_t nameLength;
+			std::uint32_t dataOffset;
+			std::uint32_t dataSize;
+		};
+
+		static_assert(std::is_trivially_copyable<Header>::value && std::is_trivially_copyable<Entry>::value &&
+			sizeof(Header) == 16U && sizeof(Entry) == 16U, "Bundle layout changed");
+
+	public:
+		static constexpr char fileExtension[] = ".pxpak";
+		static constexpr std::uint32_t currentVersion = 1U;
+
+	public:
+		// Textures of the loaded effects come from textures, decoded from the bundle when it holds them
+		explicit EffectBundle(TextureCache & textures = TextureCache::getDefault());
+		~EffectBundle() = default;
+
+	public:
+		// Fails for missing files, other formats and entries that point outside the file
+		bool open(const std::string & filePath);
+		void close();
+
+		bool contains(const std::string & name) const;
+		std::size_t getEffectCount() const;
+
+		// Every call reads the effect again, keep the definition to share it. Returns nullptr for names
+		// the bundle does not hold or that fail to load
+		std::shared_ptr<const EffectDefinition> load(const std::string & name) const;
+
+		// Pack the effect files and the textures they use. Textures that cannot be read are left out and
+		// load from their file later. Fails if an effect file cannot be read
+		static bool save(const std::string & filePath, const std::vector<std::string> & effectPaths);
+
+	private:
+		// Binary search in count entries starting at the first one
+		const char * find(std::size_t first, std::size_t count, const std::string & name, std::size_t & size) const;
+
+	private:
+		MappedFile m_file;
+		Header m_header;
+		TextureCache & m_textures;
+	};
+}
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "EffectDefinition.hpp"
+#include <loader/BinaryEffect.hpp>
+#include <loader/JsonEffect.hpp>
+
+namespace px
+{
+	EffectDefinition::EffectDefinition(const std::string & filePath, TextureCache & textures)
+	{
+		// A file that fails to load leaves the default properties
+		BinaryEffect::isBinaryFile(filePath) ? BinaryEffect::load(filePath, m_properties) : JsonEffect::load(filePath, m_properties);
+		m_properties.texture = textures.acquire(m_properties.fullParticlePath);
+	}
+
+	EffectDefinition::EffectDefinition(Properties properties) : m_properties(std::move(properties))
+	{
+	}
+
+	const EffectDefinition::Properties & EffectDefinition::getProperties() const
+	{
+		return m_properties;
+	}
+
+	EmitterShape EffectDefinition::toShape(const std::string & shape)
+	{
+		if (shape == "Circle")
+			return EmitterShape::Circle;
+		else if (shape == "Rectangle")
+			return EmitterShape::Rectangle;
+		else
+			return EmitterShape::None;
+	}
+
+	EvictionPolicy EffectDefinition::toEvictionPolicy(const std::string & eviction)
+	{
+		if (eviction == "KillOldest")
+			return EvictionPolicy::KillOldest;
+		else if (eviction == "KillNearestToDeath")
+			return EvictionPolicy::KillNearestToDeath;
+		else
+			return EvictionPolicy::DropNew;
+	}
+
+	sf::BlendMode EffectDefinition::toBlendMode(int item)
+	{
+		switch (item)
+		{
+		case 1:
+			return sf::BlendAdd;
+		case 2:
+			return sf::BlendAlpha;
+		case 3:
+			return sf::BlendMultiply;
+		default:
+			return sf::BlendNone;
+		}
+	}
+
+	int EffectDefinition::toBlendItem(const sf::BlendMode & blendMode)
+	{
+		if (blendMode == sf::BlendAdd)
+			return 1;
+		else if (blendMode == sf::BlendAlpha)
+			return 2;
+		else if (blendMode == sf::BlendMultiply)
+			return 3;
+		else
+			return 0;
+	}
+
+	bool EffectDefinition::needsStableOrder(const sf::BlendMode & blendMode)
+	{
+		return blendMode == sf::BlendAlpha || blendMode == sf::BlendNone;
+	}
+
+	RemovalMode EffectDefinition::toRemovalMode(bool stableOrder)
+	{
+		return stableOrder ? RemovalMode::Stable : RemovalMode::SwapAndPop;
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <particles/Emitters.hpp>
+#include <particles/ParticleSystem.hpp>
+#include <utils/TextureCache.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <memory>
+#include <string>
+
+namespace px
+{
+	// The parsed contents of an effect file together with its texture. A definition never changes after
+	// loading, so any number of px::EffectInstance can share one through a std::shared_ptr
+	class EffectDefinition : private sf::NonCopyable
+	{
+	public:
+		struct Properties
+		{
+			bool looping = true;
+			bool prewarm = false; // Start a looping effect in its steady state
+			bool deflect = false;
+			bool velocityPolarVector = false;
+			bool enableTorqueAff = false;
+			bool enableFadeAff = false;
+			bool enableForceAff = false;
+			unsigned int seed = 0U; // Zero picks a new seed for every instance
+			bool stableOrder = true; // Keep the draw order when dead particles are removed
+			int maxParticles = 0; // Zero leaves the particle count unbounded
+			float duration = 1.f;
+			float radius = 1.f;
+			float nrOfParticles = 1.f;
+			float torque = 0.f;
+			float maxRotation = 0.f;
+			sf::Vector2f rotationSpeed = sf::Vector2f(0.f, 0.f);
+			sf::Vector2f rotation = sf::Vector2f(0.f, 0.f);
+			sf::Vector2f lifetime = sf::Vector2f(1.f, 1.f);
+			sf::Vector2f halfSize = sf::Vector2f(1.f, 1.f);
+			sf::Vector2f position = sf::Vector2f(400.f, 400.f); // Instances are placed on their own
+			sf::Vector2f size = sf::Vector2f(0.05f, 0.05f);
+			sf::Vector2f velocity = sf::Vector2f(0.f, 0.f);
+			sf::Vector2f fader = sf::Vector2f(0.f, 0.f);
+			sf::Vector2f force = sf::Vector2f(0.f, 0.f);
+			sf::Color color = sf::Color::White;
+			std::shared_ptr<sf::Texture> texture; // Handle from a px::TextureCache, the system points into it
+			sf::BlendMode blendMode = sf::BlendNone;
+			std::string shape = "None";
+			std::string eviction = "DropNew";
+			std::string fullParticlePath;
+		};
+
+	public:
+		// Parse the effect file and get its texture from textures, which decodes each file only once.
+		// Files ending in .pxb are read as compiled effects, see px::BinaryEffect, others as JSON, see px::JsonEffect
+		explicit EffectDefinition(const std::string & filePath, TextureCache & textures = TextureCache::getDefault());
+
+		// Take properties that were loaded elsewhere, their texture included
+		explicit EffectDefinition(Properties properties);
+		~EffectDefinition() = default;
+
+	public:
+		const Properties & getProperties() const;
+
+	public:
+		// Properties hold their enums as the names and indices effect files use
+		static EmitterShape toShape(const std::string & shape);
+		static EvictionPolicy toEvictionPolicy(const std::string & eviction);
+
+		// Blend modes by their index in effect files: None, Add, Alpha and Multiply
+		static sf::BlendMode toBlendMode(int item);
+		static int toBlendItem(const sf::BlendMode & blendMode);
+
+		// Draw order only matters for alpha blended and opaque effects, the rest defaults to swap-and-pop removal
+		static bool needsStableOrder(const sf::BlendMode & blendMode);
+		static RemovalMode toRemovalMode(bool stableOrder);
+
+	private:
+		Properties m_properties;
+	};
+}
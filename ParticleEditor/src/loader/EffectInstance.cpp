@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "EffectInstance.hpp"
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <particles/Affectors.hpp>
+#include <Thor/Vectors/PolarVector2.hpp>
+#include <algorithm>
+
+namespace px
+{
+	namespace
+	{
+		// Emission is spread over each step, so a handful of steps per lifetime reaches a smooth steady state
+		const float prewarmSteps = 8.f;
+	}
+
+	EffectInstance::EffectInstance(std::shared_ptr<const EffectDefinition> definition, const sf::Vector2f & position) :
+		m_definition(std::move(definition)), m_position(position), m_emitter(std::make_unique<UniversalEmitter>()),
+		m_dirtyParameters(AllParameters)
+	{
+		const EffectDefinition::Properties & properties = m_definition->getProperties();
+
+		m_particleSystem.setRemovalMode(EffectDefinition::toRemovalMode(properties.stableOrder));
+		m_particleSystem.setCapacity(static_cast<std::size_t>(std::max(properties.maxParticles, 0)),
+			EffectDefinition::toEvictionPolicy(properties.eviction));
+
+		// Affectors
+		if (properties.enableTorqueAff)
+			m_particleSystem.addAffector(TorqueAffector(properties.torque));
+		if (properties.enableForceAff)
+			m_particleSystem.addAffector(ForceAffector(properties.force));
+		if (properties.enableFadeAff)
+			m_particleSystem.addAffector(FadeAffector(properties.fader.x, properties.fader.y));
+
+		// Set texture and prepare emitter
+		m_particleSystem.setTexture(*properties.texture);
+		m_emitter->seed(properties.seed != 0U ? properties.seed : makeSeed());
+		properties.looping ? m_emitterConnection = m_particleSystem.addEmitter(refEmitter(*m_emitter)) :
+							 m_emitterConnection = m_particleSystem.addEmitter(refEmitter(*m_emitter), sf::seconds(properties.duration));
+
+		// Steady state is reached once the longest lived particles emitted first have died
+		if (properties.looping && properties.prewarm)
+		{
+			updateEmitter();
+			m_particleSystem.prewarm(sf::seconds(properties.lifetime.y), sf::seconds(properties.lifetime.y / prewarmSteps));
+		}
+	}
+
+	bool EffectInstance::isConnected() const
+	{
+		return m_emitterConnection.isConnected();
+	}
+
+	bool EffectInstance::isFinished() const
+	{
+		return !isConnected() && m_particleSystem.getParticleCount() == 0U;
+	}
+
+	const EffectDefinition & EffectInstance::getDefinition() const
+	{
+		return *m_definition;
+	}
+
+	const ParticleSystem & EffectInstance::getParticleSystem() const
+	{
+		return m_particleSystem;
+	}
+
+	const sf::Vector2f & EffectInstance::getPosition() const
+	{
+		return m_position;
+	}
+
+	void EffectInstance::setPosition(const sf::Vector2f & position)
+	{
+		m_position = position;
+		m_dirtyParameters |= Position;
+	}
+
+	void EffectInstance::setThreadPool(ThreadPool * pool)
+	{
+		m_particleSystem.setThreadPool(pool);
+	}
+
+	void EffectInstance::setFixedTimestep(sf::Time step, unsigned int maxSubsteps)
+	{
+		m_particleSystem.setFixedTimestep(step, maxSubsteps);
+	}
+
+	void EffectInstance::setEvaluationMode(EvaluationMode mode)
+	{
+		m_particleSystem.setEvaluationMode(mode);
+	}
+
+	void EffectInstance::update(sf::Time dt)
+	{
+		// The distributions only depend on the properties and the position, so they are built when those change
+		if (m_dirtyParameters != 0U)
+			updateEmitter();
+
+		m_particleSystem.update(dt);
+	}
+
+	void EffectInstance::draw(sf::RenderTarget & target, sf::RenderStates states) const
+	{
+		const sf::BlendMode & blendMode = m_definition->getProperties().blendMode;
+		blendMode == sf::BlendNone ? target.draw(m_particleSystem) : target.draw(m_particleSystem, blendMode);
+	}
+
+	void EffectInstance::configureEmitter(UniversalEmitter & emitter, const EffectDefinition::Properties & properties,
+		unsigned int parameters)
+	{
+		if (parameters & EmissionRate)
+			emitter.setEmissionRate(properties.nrOfParticles);
+		if (parameters & Lifetime)
+			emitter.setParticleLifetime(sf::seconds(properties.lifetime.x), sf::seconds(properties.lifetime.y));
+		if (parameters & Scale)
+			emitter.setParticleScale(properties.size.x, properties.size.y);
+		if (parameters & Rotation)
+			emitter.setParticleRotation(properties.rotation.x, properties.rotation.y);
+		if (parameters & RotationSpeed)
+			emitter.setParticleRotationSpeed(properties.rotationSpeed.x, properties.rotationSpeed.y);
+		if (parameters & Color)
+			emitter.setParticleColor(properties.color);
+
+		if (parameters & Velocity)
+		{
+			// Polar velocities are (radius, angle) and converted once here
+			const sf::Vector2f velocity = properties.velocityPolarVector ?
+				sf::Vector2f(thor::PolarVector2f(properties.velocity.x, properties.velocity.y)) : properties.velocity;
+			emitter.setParticleVelocity(velocity, properties.deflect ? properties.maxRotation : 0.f);
+		}
+
+		// Shape and deflection pick the px::Emitter specialization the emitter runs
+		if (parameters & Position)
+		{
+			emitter.setParticlePosition(EffectDefinition::toShape(properties.shape), properties.position, properties.radius,
+				properties.halfSize);
+		}
+	}
+
+	// The definition holds the same properties for every instance, only the position is the instance's own
+	void EffectInstance::updateEmitter()
+	{
+		const EffectDefinition::Properties & properties = m_definition->getProperties();
+		configureEmitter(*m_emitter, properties, m_dirtyParameters & ~Position);
+
+		if (m_dirtyParameters & Position)
+			m_emitter->setParticlePosition(EffectDefinition::toShape(properties.shape), m_position, properties.radius, properties.halfSize);
+
+		m_dirtyParameters = 0U;
+	}
+}
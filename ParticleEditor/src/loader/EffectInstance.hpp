@@ -0,0 +1,87 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <loader/EffectDefinition.hpp>
+#include <particles/Emitters.hpp>
+#include <particles/ParticleSystem.hpp>
+
+namespace sf
+{
+	class RenderTarget;
+}
+
+namespace px
+{
+	// One playing effect. Everything that does not change while it plays lives in the shared definition,
+	// an instance only holds its position, particles, emitter state and timers. Spawning an effect
+	// again costs no file read, parse or texture upload. Instances can be moved and stored by value,
+	// a moved-from instance may only be assigned to or destroyed
+	class EffectInstance : public sf::Drawable
+	{
+	public:
+		EffectInstance(std::shared_ptr<const EffectDefinition> definition, const sf::Vector2f & position);
+		EffectInstance(EffectInstance && other) = default;
+		~EffectInstance() = default;
+
+		EffectInstance & operator=(EffectInstance && other) = default;
+
+	public:
+		// Determine if the particle system has stopped playing
+		bool isConnected() const;
+
+		// Stopped playing and no particles are left
+		bool isFinished() const;
+
+		const EffectDefinition & getDefinition() const;
+		const ParticleSystem & getParticleSystem() const;
+		const sf::Vector2f & getPosition() const;
+
+		// Move the emitter, the emitter configuration is rebuilt on the next update
+		void setPosition(const sf::Vector2f & position);
+
+		// Update the particles on the workers of pool, the pool must outlive the instance. nullptr updates serially
+		void setThreadPool(ThreadPool * pool);
+
+		// Simulate in fixed steps, see ParticleSystem::setFixedTimestep. A step of zero follows the update time
+		void setFixedTimestep(sf::Time step, unsigned int maxSubsteps = 8U);
+
+		// Evaluate the particles from their age instead of stepping them, see px::EvaluationMode
+		void setEvaluationMode(EvaluationMode mode);
+
+	public:
+		void update(sf::Time dt);
+		virtual void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+
+	public:
+		// Emitter parameters, or-ed together to tell configureEmitter what to rebuild
+		enum EmitterParameter : unsigned int
+		{
+			EmissionRate = 1U << 0,
+			Lifetime = 1U << 1,
+			Scale = 1U << 2,
+			Rotation = 1U << 3,
+			RotationSpeed = 1U << 4,
+			Color = 1U << 5,
+			Velocity = 1U << 6,
+			Position = 1U << 7,
+			AllParameters = (1U << 8) - 1U
+		};
+
+		// Apply the emitter parameters selected by the parameters mask from the properties
+		static void configureEmitter(UniversalEmitter & emitter, const EffectDefinition::Properties & properties,
+			unsigned int parameters);
+
+	private:
+		void updateEmitter();
+
+	private:
+		std::shared_ptr<const EffectDefinition> m_definition;
+		sf::Vector2f m_position;
+		ParticleSystem m_particleSystem;
+		std::unique_ptr<UniversalEmitter> m_emitter; // The system refers to it, so it must not move with the instance
+		thor::Connection m_emitterConnection;
+		unsigned int m_dirtyParameters;
+	};
+}
@@ -0,0 +1,236 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "JsonEffect.hpp"
+#include <utils/MappedFile.hpp>
+#include <algorithm>
+#include <cstring>
+#include <json.hpp>
+#include <vector>
+
+using nlohmann::json;
+
+namespace px
+{
+	namespace JsonEffect
+	{
+		namespace
+		{
+			using Properties = EffectDefinition::Properties;
+
+			// Numbers and booleans arrive as a double, element is the index within an array value
+			using NumberSetter = void(*)(Properties & properties, std::size_t element, double value);
+			using StringSetter = void(*)(Properties & properties, const std::string & value);
+
+			template <bool Properties::* Member>
+			void setBool(Properties & properties, std::size_t, double value)
+			{
+				properties.*Member = value != 0.0;
+			}
+
+			template <typename T, T Properties::* Member>
+			void setNumber(Properties & properties, std::size_t, double value)
+			{
+				properties.*Member = static_cast<T>(value);
+			}
+
+			template <sf::Vector2f Properties::* Member>
+			void setVector(Properties & properties, std::size_t element, double value)
+			{
+				(element == 0U ? (properties.*Member).x : (properties.*Member).y) = static_cast<float>(value);
+			}
+
+			template <std::string Properties::* Member>
+			void setString(Properties & properties, const std::string & value)
+			{
+				properties.*Member = value;
+			}
+
+			void setColor(Properties & properties, std::size_t element, double value)
+			{
+				sf::Uint8* channels[] = { &properties.color.r, &properties.color.g, &properties.color.b, &properties.color.a };
+				*channels[element] = static_cast<sf::Uint8>(value);
+			}
+
+			void setBlendMode(Properties & properties, std::size_t, double value)
+			{
+				properties.blendMode = EffectDefinition::toBlendMode(static_cast<int>(value));
+			}
+
+			// An array value holds at least elements numbers, further ones are ignored. Zero for a single value
+			struct Field
+			{
+				const char* key;
+				NumberSetter number;
+				StringSetter string;
+				std::size_t elements;
+			};
+
+			// Sorted by key for the binary search, the keys of the editor's files
+			const Field fields[] =
+			{
+				{ "blendMode", setBlendMode, nullptr, 0U },
+				{ "circleRadius", setNumber<float, &Properties::radius>, nullptr, 0U },
+				{ "color", setColor, nullptr, 4U },
+				{ "deflect", setBool<&Properties::deflect>, nullptr, 0U },
+				{ "duration", setNumber<float, &Properties::duration>, nullptr, 0U },
+				{ "enableFadeAff", setBool<&Properties::enableFadeAff>, nullptr, 0U },
+				{ "enableForceAff", setBool<&Properties::enableForceAff>, nullptr, 0U },
+				{ "enableTorqueAff", setBool<&Properties::enableTorqueAff>, nullptr, 0U },
+				{ "eviction", nullptr, setString<&Properties::eviction>, 0U },
+				{ "fader", setVector<&Properties::fader>, nullptr, 2U },
+				{ "force", setVector<&Properties::force>, nullptr, 2U },
+				{ "lifetime", setVector<&Properties::lifetime>, nullptr, 2U },
+				{ "looping", setBool<&Properties::looping>, nullptr, 0U },
+				{ "maxParticles", setNumber<int, &Properties::maxParticles>, nullptr, 0U },
+				{ "maxRotation", setNumber<float, &Properties::maxRotation>, nullptr, 0U },
+				{ "particles", setNumber<float, &Properties::nrOfParticles>, nullptr, 0U },
+				{ "position", setVector<&Properties::position>, nullptr, 2U },
+				{ "prewarm", setBool<&Properties::prewarm>, nullptr, 0U },
+				{ "rectHalfSize", setVector<&Properties::halfSize>, nullptr, 2U },
+				{ "rotation", setVector<&Properties::rotation>, nullptr, 2U },
+				{ "rotationSpeed", setVector<&Properties::rotationSpeed>, nullptr, 2U },
+				{ "seed", setNumber<unsigned int, &Properties::seed>, nullptr, 0U },
+				{ "shape", nullptr, setString<&Properties::shape>, 0U },
+				{ "size", setVector<&Properties::size>, nullptr, 2U },
+				{ "stableOrder", setBool<&Properties::stableOrder>, nullptr, 0U },
+				{ "texture", nullptr, setString<&Properties::fullParticlePath>, 0U },
+				{ "torque", setNumber<float, &Properties::torque>, nullptr, 0U },
+				{ "velPolarVector", setBool<&Properties::velocityPolarVector>, nullptr, 0U },
+				{ "velocity", setVector<&Properties::velocity>, nullptr, 2U }
+			};
+
+			const Field* findField(const std::string & key)
+			{
+				auto found = std::lower_bound(std::begin(fields), std::end(fields), key.c_str(), [](const Field & field, const char* k)
+				{
+					return std::strcmp(field.key, k) < 0;
+				});
+
+				return found != std::end(fields) && std::strcmp(found->key, key.c_str()) == 0 ? found : nullptr;
+			}
+
+			// Values of the top level object go to the field of their key, the elements of an array value are
+			// counted. A known key with a value of another shape, nested deeper or too short an array fails the
+			// load like it failed to convert before. Values of unknown keys are skipped however they are nested
+			class Handler : public json::json_sax_t
+			{
+			public:
+				explicit Handler(Properties & properties) : m_properties(properties), m_field(nullptr), m_element(0U),
+					m_stableOrderSet(false)
+				{
+				}
+
+				bool null() override { return !m_field && !m_containers.empty(); }
+				bool boolean(bool value) override { return number(value ? 1.0 : 0.0); }
+				bool number_integer(number_integer_t value) override { return number(static_cast<double>(value)); }
+				bool number_unsigned(number_unsigned_t value) override { return number(static_cast<double>(value)); }
+				bool number_float(number_float_t value, const string_t &) override { return number(value); }
+
+				bool string(string_t & value) override
+				{
+					if (!m_field)
+						return !m_containers.empty();
+					if (!m_field->string || m_containers.size() != 1U)
+						return false;
+
+					m_field->string(m_properties, value);
+					return true;
+				}
+
+				bool start_object(std::size_t) override
+				{
+					if (m_field)
+						return false;
+
+					m_containers.push_back(Container::Object);
+					return true;
+				}
+
+				bool key(string_t & value) override
+				{
+					if (m_containers.size() == 1U)
+					{
+						m_field = findField(value);
+						m_element = 0U;
+						m_stableOrderSet |= m_field && std::strcmp(m_field->key, "stableOrder") == 0;
+					}
+					return true;
+				}
+
+				bool end_object() override
+				{
+					m_containers.pop_back();
+					return true;
+				}
+
+				bool start_array(std::size_t) override
+				{
+					if (m_containers.empty() || (m_field && (m_field->elements == 0U || m_containers.size() != 1U)))
+						return false;
+
+					m_containers.push_back(Container::Array);
+					return true;
+				}
+
+				bool end_array() override
+				{
+					m_containers.pop_back();
+					return !m_field || m_containers.size() != 1U || m_element >= m_field->elements;
+				}
+
+				bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) override
+				{
+					return false;
+				}
+
+				bool finish()
+				{
+					if (!m_stableOrderSet)
+						m_properties.stableOrder = EffectDefinition::needsStableOrder(m_properties.blendMode);
+					return true;
+				}
+
+			private:
+				enum class Container
+				{
+					Object,
+					Array
+				};
+
+				// A single value right in the top level object or an element of the array there
+				bool number(double value)
+				{
+					if (!m_field)
+						return !m_containers.empty();
+					if (!m_field->number || (m_containers.size() == 1U) != (m_field->elements == 0U))
+						return false;
+
+					if (m_element < std::max<std::size_t>(m_field->elements, 1U))
+						m_field->number(m_properties, m_element, value);
+					++m_element;
+					return true;
+				}
+
+			private:
+				Properties & m_properties;
+				std::vector<Container> m_containers;
+				const Field* m_field;
+				std::size_t m_element;
+				bool m_stableOrderSet;
+			};
+		}
+
+		bool read(const char * data, std::size_t size, EffectDefinition::Properties & properties)
+		{
+			Handler handler(properties);
+			return json::sax_parse(data, data + size, &handler) && handler.finish();
+		}
+
+		bool load(const std::string & filePath, EffectDefinition::Properties & properties)
+		{
+			MappedFile file;
+			return file.open(filePath) && read(file.getData(), file.getSize(), properties);
+		}
+	}
+}
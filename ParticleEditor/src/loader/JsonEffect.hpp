@@ -0,0 +1,19 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <loader/EffectDefinition.hpp>
+
+namespace px
+{
+	// Effect files in JSON. The file is read as a stream of SAX events that are written straight into the
+	// properties through a static table of keys, no document is built. Keys the table does not know are skipped
+	namespace JsonEffect
+	{
+		// Keys missing from the data leave their properties as they are, except stableOrder, which then follows
+		// the blend mode. Fails for malformed data, properties may be partly filled then. The texture is not loaded
+		bool read(const char * data, std::size_t size, EffectDefinition::Properties & properties);
+		bool load(const std::string & filePath, EffectDefinition::Properties & properties);
+	}
+}
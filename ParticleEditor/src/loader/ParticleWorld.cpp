@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "ParticleWorld.hpp"
+#include <utils/ThreadPool.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+
+namespace px
+{
+	ParticleWorld::ParticleWorld(ThreadPool * pool, TextureCache & textures) : m_threadPool(pool), m_textures(textures)
+	{
+	}
+
+	void ParticleWorld::mount(const EffectBundle & bundle)
+	{
+		m_bundles.push_back(&bundle);
+	}
+
+	EffectInstance & ParticleWorld::add(const std::string & filePath, const sf::Vector2f & position)
+	{
+		auto & definition = m_definitions[filePath];
+		for (std::size_t i = 0; !definition && i < m_bundles.size(); ++i)
+			definition = m_bundles[i]->load(filePath);
+		if (!definition)
+			definition = std::make_shared<const EffectDefinition>(filePath, m_textures);
+
+		return add(definition, position);
+	}
+
+	EffectInstance & ParticleWorld::add(std::shared_ptr<const EffectDefinition> definition, const sf::Vector2f & position)
+	{
+		m_effects.emplace_back(std::move(definition), position);
+		m_effects.back().setThreadPool(m_threadPool);
+		return m_effects.back();
+	}
+
+	void ParticleWorld::remove(const EffectInstance & effect)
+	{
+		m_effects.erase(std::remove_if(m_effects.begin(), m_effects.end(), [&effect](const EffectInstance & e)
+		{
+			return &e == &effect;
+		}), m_effects.end());
+	}
+
+	void ParticleWorld::clear()
+	{
+		m_effects.clear();
+	}
+
+	std::size_t ParticleWorld::getEffectCount() const
+	{
+		return m_effects.size();
+	}
+
+	void ParticleWorld::update(sf::Time dt)
+	{
+		m_textures.uploadDecoded();
+
+		// One effect per task, large effects split their own update further on the same pool
+		const auto updateRange = [this, dt](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				m_effects[i].update(dt);
+		};
+
+		m_threadPool ? m_threadPool->parallelFor(m_effects.size(), 1U, updateRange) : updateRange(0U, m_effects.size());
+
+		m_effects.erase(std::remove_if(m_effects.begin(), m_effects.end(), [](const EffectInstance & e)
+		{
+			return e.isFinished();
+		}), m_effects.end());
+	}
+
+	void ParticleWorld::draw(sf::RenderTarget & target, sf::RenderStates states) const
+	{
+		buildBatches(states.blendMode);
+
+		// Every effect writes its quads straight into its slice of the shared vertex array
+		const auto writeRange = [this](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				m_effects[i].getParticleSystem().writeVertices(m_vertices.data() + m_vertexOffsets[i]);
+		};
+
+		m_threadPool ? m_threadPool->parallelFor(m_effects.size(), 1U, writeRange) : writeRange(0U, m_effects.size());
+
+		for (const auto & batch : m_batches)
+		{
+			if (batch.count == 0U)
+				continue;
+
+			states.texture = batch.texture;
+			states.blendMode = batch.blendMode;
+			target.draw(m_vertices.data() + batch.begin, batch.count, sf::Quads, states);
+		}
+	}
+
+	// Assign every effect to the batch of its texture file and blend mode and find its first vertex
+	void ParticleWorld::buildBatches(const sf::BlendMode & defaultBlendMode) const
+	{
+		m_batches.clear();
+		m_vertexOffsets.resize(m_effects.size());
+
+		for (std::size_t i = 0; i < m_effects.size(); ++i)
+		{
+			const EffectDefinition::Properties & properties = m_effects[i].getDefinition().getProperties();
+			const ParticleSystem & system = m_effects[i].getParticleSystem();
+
+			// Effects without a blend mode draw with the one of the render states, like a single loader does
+			const sf::BlendMode blendMode = properties.blendMode == sf::BlendNone ? defaultBlendMode : properties.blendMode;
+
+			auto batch = std::find_if(m_batches.begin(), m_batches.end(), [&](const Batch & b)
+			{
+				return b.blendMode == blendMode && *b.texturePath == properties.fullParticlePath;
+			});
+
+			if (batch == m_batches.end())
+				batch = m_batches.insert(m_batches.end(), Batch{ &properties.fullParticlePath, system.getTexture(), blendMode, 0U, 0U });
+
+			// Hold the batch index until the batch sizes are known
+			m_vertexOffsets[i] = static_cast<std::size_t>(batch - m_batches.begin());
+			batch->count += system.getVertexCount();
+		}
+
+		std::size_t vertexCount = 0;
+		for (auto & batch : m_batches)
+		{
+			batch.begin = vertexCount;
+			vertexCount += batch.count;
+			batch.count = 0U;
+		}
+
+		for (std::size_t i = 0; i < m_effects.size(); ++i)
+		{
+			Batch & batch = m_batches[m_vertexOffsets[i]];
+			m_vertexOffsets[i] = batch.begin + batch.count;
+			batch.count += m_effects[i].getParticleSystem().getVertexCount();
+		}
+
+		m_vertices.resize(vertexCount);
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <loader/EffectBundle.hpp>
+#include <loader/EffectInstance.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace px
+{
+	// Owns many effects, updates them together across a thread pool and draws all effects that share a
+	// texture file and blend mode with a single draw call. Batches are drawn in the order their first
+	// effect was added, so effects of different batches do not interleave
+	class ParticleWorld : public sf::Drawable, private sf::NonCopyable
+	{
+	public:
+		// The pool must outlive the world, nullptr updates and draws serially. Effect files get their textures
+		// from textures, which must outlive the world too
+		explicit ParticleWorld(ThreadPool * pool = nullptr, TextureCache & textures = TextureCache::getDefault());
+		~ParticleWorld() = default;
+
+	public:
+		// Effect files are looked up in the mounted bundles first, in the order they were mounted, and read
+		// from disk only when no bundle holds them. The bundle must outlive the world
+		void mount(const EffectBundle & bundle);
+
+		// Effects are stored by value, the reference stays valid until the next add, remove or update.
+		// Each file is loaded once, later effects from the same file share its definition
+		EffectInstance & add(const std::string & filePath, const sf::Vector2f & position);
+		EffectInstance & add(std::shared_ptr<const EffectDefinition> definition, const sf::Vector2f & position);
+		void remove(const EffectInstance & effect);
+
+		// Removes the effects, the loaded definitions are kept
+		void clear();
+		std::size_t getEffectCount() const;
+
+	public:
+		// Effects that played once and have no particles left are removed afterwards. Textures the cache decoded
+		// in the background are uploaded first, effects draw nothing until theirs has arrived
+		void update(sf::Time dt);
+
+	private:
+		// Effects loading the same texture file draw with the texture of the first one
+		struct Batch
+		{
+			const std::string * texturePath;
+			const sf::Texture * texture;
+			sf::BlendMode blendMode;
+			std::size_t begin;
+			std::size_t count;
+		};
+
+	private:
+		virtual void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+		void buildBatches(const sf::BlendMode & defaultBlendMode) const;
+
+	private:
+		ThreadPool* m_threadPool;
+		TextureCache & m_textures;
+		std::vector<EffectInstance> m_effects;
+		std::vector<const EffectBundle*> m_bundles;
+		std::unordered_map<std::string, std::shared_ptr<const EffectDefinition>> m_definitions;
+		mutable std::vector<Batch> m_batches;
+		mutable std::vector<std::size_t> m_vertexOffsets;
+		mutable std::vector<sf::Vertex> m_vertices;
+	};
+}
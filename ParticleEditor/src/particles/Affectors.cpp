@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Affectors.hpp"
+#include <utils/FloatingPoint.hpp>
+
+namespace px
+{
+	ForceAffector::ForceAffector(sf::Vector2f acceleration) : m_acceleration(acceleration)
+	{
+	}
+
+	void ForceAffector::operator()(Particle & particle, sf::Time dt) const
+	{
+		particle.velocity += dt.asSeconds() * m_acceleration;
+	}
+
+	sf::Vector2f ForceAffector::getAcceleration() const
+	{
+		return m_acceleration;
+	}
+
+	TorqueAffector::TorqueAffector(float angularAcceleration) : m_angularAcceleration(angularAcceleration)
+	{
+	}
+
+	void TorqueAffector::operator()(Particle & particle, sf::Time dt) const
+	{
+		particle.rotationSpeed += dt.asSeconds() * m_angularAcceleration;
+	}
+
+	float TorqueAffector::getAngularAcceleration() const
+	{
+		return m_angularAcceleration;
+	}
+
+	FadeAffector::FadeAffector(float inRatio, float outRatio) : m_inRatio(inRatio), m_outRatio(outRatio)
+	{
+	}
+
+	void FadeAffector::operator()(Particle & particle, sf::Time) const
+	{
+		const float progress = getElapsedRatio(particle);
+
+		if (progress < m_inRatio)
+			particle.color.a = static_cast<sf::Uint8>(256.f * progress / m_inRatio);
+		else if (progress > 1.f - m_outRatio)
+			particle.color.a = static_cast<sf::Uint8>(256.f * (1.f - progress) / m_outRatio);
+	}
+
+	void FadeAffector::apply(ParticleStore & particles, std::size_t begin, std::size_t end, float) const
+	{
+		const float* passedLifetime = particles.passedLifetime.data();
+		const float* totalLifetime = particles.totalLifetime.data();
+		sf::Color* color = particles.color.data();
+
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const float progress = passedLifetime[i] / totalLifetime[i];
+
+			if (progress < m_inRatio)
+				color[i].a = static_cast<sf::Uint8>(256.f * progress / m_inRatio);
+			else if (progress > 1.f - m_outRatio)
+				color[i].a = static_cast<sf::Uint8>(256.f * (1.f - progress) / m_outRatio);
+		}
+	}
+
+	// The alpha only depends on the age, there is nothing to undo
+	void FadeAffector::evaluate(ParticleStore & particles, std::size_t begin, std::size_t end, float sign) const
+	{
+		if (sign > 0.f)
+			apply(particles, begin, end, 0.f);
+	}
+
+	float FadeAffector::getInRatio() const
+	{
+		return m_inRatio;
+	}
+
+	float FadeAffector::getOutRatio() const
+	{
+		return m_outRatio;
+	}
+
+	ScaleAffector::ScaleAffector(sf::Vector2f scaleFactor) : m_scaleFactor(scaleFactor)
+	{
+	}
+
+	void ScaleAffector::operator()(Particle & particle, sf::Time dt) const
+	{
+		particle.scale += dt.asSeconds() * m_scaleFactor;
+	}
+
+	void ScaleAffector::apply(ParticleStore & particles, std::size_t begin, std::size_t end, float dt) const
+	{
+		const float dx = m_scaleFactor.x * dt;
+		const float dy = m_scaleFactor.y * dt;
+
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			particles.scaleX[i] += dx;
+			particles.scaleY[i] += dy;
+		}
+	}
+
+	void ScaleAffector::evaluate(ParticleStore & particles, std::size_t begin, std::size_t end, float sign) const
+	{
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const float age = sign * particles.passedLifetime[i];
+			particles.scaleX[i] += m_scaleFactor.x * age;
+			particles.scaleY[i] += m_scaleFactor.y * age;
+		}
+	}
+
+	ColorAffector::ColorAffector(const thor::ColorGradient & gradient) : m_gradient(gradient)
+	{
+	}
+
+	void ColorAffector::operator()(Particle & particle, sf::Time) const
+	{
+		particle.color = m_gradient.sampleColor(getElapsedRatio(particle));
+	}
+
+	void ColorAffector::apply(ParticleStore & particles, std::size_t begin, std::size_t end, float) const
+	{
+		for (std::size_t i = begin; i < end; ++i)
+			particles.color[i] = m_gradient.sampleColor(particles.passedLifetime[i] / particles.totalLifetime[i]);
+	}
+
+	void ColorAffector::evaluate(ParticleStore & particles, std::size_t begin, std::size_t end, float sign) const
+	{
+		if (sign > 0.f)
+			apply(particles, begin, end, 0.f);
+	}
+
+	AffectorSet::AffectorSet() : m_acceleration(0.f, 0.f), m_angularAcceleration(0.f)
+	{
+	}
+
+	void AffectorSet::add(const BuiltinAffector & affector)
+	{
+		if (const auto force = std::get_if<ForceAffector>(&affector))
+			m_acceleration += force->getAcceleration();
+		else if (const auto torque = std::get_if<TorqueAffector>(&affector))
+			m_angularAcceleration += torque->getAngularAcceleration();
+		else if (const auto fade = std::get_if<FadeAffector>(&affector))
+			m_ordered.push_back(*fade);
+		else if (const auto scale = std::get_if<ScaleAffector>(&affector))
+			m_ordered.push_back(*scale);
+		else if (const auto color = std::get_if<ColorAffector>(&affector))
+			m_ordered.push_back(*color);
+	}
+
+	void AffectorSet::clear()
+	{
+		m_acceleration = sf::Vector2f(0.f, 0.f);
+		m_angularAcceleration = 0.f;
+		m_ordered.clear();
+	}
+
+	bool AffectorSet::empty() const
+	{
+		return m_acceleration == sf::Vector2f(0.f, 0.f) && m_angularAcceleration == 0.f && m_ordered.empty();
+	}
+
+	void AffectorSet::apply(ParticleStore & particles, std::size_t begin, std::size_t end, float dt) const
+	{
+		const float dvx = m_acceleration.x * dt;
+		const float dvy = m_acceleration.y * dt;
+		const float dw = m_angularAcceleration * dt;
+
+		if (dvx != 0.f || dvy != 0.f || dw != 0.f)
+		{
+			float* velocityX = particles.velocityX.data();
+			float* velocityY = particles.velocityY.data();
+			float* rotationSpeed = particles.rotationSpeed.data();
+
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				velocityX[i] += dvx;
+				velocityY[i] += dvy;
+				rotationSpeed[i] += dw;
+			}
+		}
+
+		for (const auto & affector : m_ordered)
+			std::visit([&](const auto & kind) { kind.apply(particles, begin, end, dt); }, affector);
+	}
+
+	void AffectorSet::evaluate(ParticleStore & particles, std::size_t begin, std::size_t end, float sign) const
+	{
+		float* positionX = particles.positionX.data();
+		float* positionY = particles.positionY.data();
+		float* velocityX = particles.velocityX.data();
+		float* velocityY = particles.velocityY.data();
+		float* rotation = particles.rotation.data();
+		float* rotationSpeed = particles.rotationSpeed.data();
+		const float* passedLifetime = particles.passedLifetime.data();
+		const sf::Vector2f halfAcceleration = 0.5f * m_acceleration;
+		const float halfAngularAcceleration = 0.5f * m_angularAcceleration;
+
+		// p = p0 + (v0 + a * t / 2) * t and v = v0 + a * t. Going back, v0 is recovered first
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const float age = passedLifetime[i];
+
+			if (sign < 0.f)
+			{
+				velocityX[i] -= m_acceleration.x * age;
+				velocityY[i] -= m_acceleration.y * age;
+				rotationSpeed[i] -= m_angularAcceleration * age;
+			}
+
+			positionX[i] += sign * (velocityX[i] + halfAcceleration.x * age) * age;
+			positionY[i] += sign * (velocityY[i] + halfAcceleration.y * age) * age;
+			rotation[i] += sign * (rotationSpeed[i] + halfAngularAcceleration * age) * age;
+
+			if (sign > 0.f)
+			{
+				velocityX[i] += m_acceleration.x * age;
+				velocityY[i] += m_acceleration.y * age;
+				rotationSpeed[i] += m_angularAcceleration * age;
+			}
+		}
+
+		for (const auto & affector : m_ordered)
+			std::visit([&](const auto & kind) { kind.evaluate(particles, begin, end, sign); }, affector);
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <particles/ParticleStore.hpp>
+#include <Thor/Graphics/ColorGradient.hpp>
+#include <variant>
+#include <vector>
+
+namespace px
+{
+	// Every affector applies over a frame of dt seconds with apply() and over the whole age of each
+	// particle with evaluate(), which a sign of -1 undoes as far as the affector can be undone.
+	// Forces and torques have neither, px::AffectorSet sums their accelerations and applies them in one pass,
+	// or in closed form over the age
+
+	// Constant acceleration applied to the particle velocity
+	class ForceAffector
+	{
+	public:
+		explicit ForceAffector(sf::Vector2f acceleration);
+		void operator()(Particle & particle, sf::Time dt) const;
+		sf::Vector2f getAcceleration() const;
+
+	private:
+		sf::Vector2f m_acceleration;
+	};
+
+	// Constant angular acceleration applied to the particle rotation speed
+	class TorqueAffector
+	{
+	public:
+		explicit TorqueAffector(float angularAcceleration);
+		void operator()(Particle & particle, sf::Time dt) const;
+		float getAngularAcceleration() const;
+
+	private:
+		float m_angularAcceleration;
+	};
+
+	// Fades the particle in and out, the ratios are fractions of the particle lifetime
+	class FadeAffector
+	{
+	public:
+		FadeAffector(float inRatio, float outRatio);
+		void operator()(Particle & particle, sf::Time dt) const;
+		void apply(ParticleStore & particles, std::size_t begin, std::size_t end, float dt) const;
+		void evaluate(ParticleStore & particles, std::size_t begin, std::size_t end, float sign) const;
+		float getInRatio() const;
+		float getOutRatio() const;
+
+	private:
+		float m_inRatio;
+		float m_outRatio;
+	};
+
+	// Scales the particle by scaleFactor every second
+	class ScaleAffector
+	{
+	public:
+		explicit ScaleAffector(sf::Vector2f scaleFactor);
+		void operator()(Particle & particle, sf::Time dt) const;
+		void apply(ParticleStore & particles, std::size_t begin, std::size_t end, float dt) const;
+		void evaluate(ParticleStore & particles, std::size_t begin, std::size_t end, float sign) const;
+
+	private:
+		sf::Vector2f m_scaleFactor;
+	};
+
+	// Colors the particle from a gradient sampled at its elapsed lifetime ratio
+	class ColorAffector
+	{
+	public:
+		explicit ColorAffector(const thor::ColorGradient & gradient);
+		void operator()(Particle & particle, sf::Time dt) const;
+		void apply(ParticleStore & particles, std::size_t begin, std::size_t end, float dt) const;
+		void evaluate(ParticleStore & particles, std::size_t begin, std::size_t end, float sign) const;
+
+	private:
+		thor::ColorGradient m_gradient;
+	};
+
+	using BuiltinAffector = std::variant<ForceAffector, TorqueAffector, FadeAffector, ScaleAffector, ColorAffector>;
+
+	// The built-in affectors of a system, applied to a whole range of particles at a time so the kind is
+	// dispatched once per batch. Forces and torques add up and run in one pass, the other kinds
+	// follow in the order they were added. evaluate() turns spawn states into the states at the
+	// particle ages, motion included, and a sign of -1 turns them back
+	class AffectorSet
+	{
+	public:
+		AffectorSet();
+
+	public:
+		void add(const BuiltinAffector & affector);
+		void clear();
+		bool empty() const;
+		void apply(ParticleStore & particles, std::size_t begin, std::size_t end, float dt) const;
+		void evaluate(ParticleStore & particles, std::size_t begin, std::size_t end, float sign) const;
+
+	private:
+		using OrderedAffector = std::variant<FadeAffector, ScaleAffector, ColorAffector>;
+
+	private:
+		sf::Vector2f m_acceleration;
+		float m_angularAcceleration;
+		std::vector<OrderedAffector> m_ordered;
+	};
+}
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Distributions.hpp"
+#include <particles/Simd.hpp>
+#include <utils/Random.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace px
+{
+	namespace Distributions
+	{
+		namespace
+		{
+			const float degToRad = 3.141592654f / 180.f;
+
+			// x holds u in [0, 1) and y the angle, both are replaced by the point
+			void toDisc(float* x, float* y, std::size_t begin, std::size_t end, sf::Vector2f center, float radius)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					float sine, cosine;
+					simd::sincos(y[i], sine, cosine);
+					const float distance = radius * std::sqrt(x[i]);
+					x[i] = center.x + distance * cosine;
+					y[i] = center.y + distance * sine;
+				}
+			}
+
+			// x holds the angle, both are replaced by the rotated direction
+			void rotate(float* x, float* y, std::size_t begin, std::size_t end, sf::Vector2f direction)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					float sine, cosine;
+					simd::sincos(x[i], sine, cosine);
+					x[i] = cosine * direction.x - sine * direction.y;
+					y[i] = sine * direction.x + cosine * direction.y;
+				}
+			}
+
+#if defined(PX_SIMD_AVX2)
+
+			std::size_t toDiscSimd(float* x, float* y, std::size_t count, sf::Vector2f center, float radius)
+			{
+				const __m256 cx = _mm256_set1_ps(center.x);
+				const __m256 cy = _mm256_set1_ps(center.y);
+				const __m256 r = _mm256_set1_ps(radius);
+
+				std::size_t i = 0;
+				for (; i + 8U <= count; i += 8U)
+				{
+					__m256 sine, cosine;
+					simd::sincos(_mm256_loadu_ps(y + i), sine, cosine);
+					const __m256 distance = _mm256_mul_ps(r, _mm256_sqrt_ps(_mm256_loadu_ps(x + i)));
+					_mm256_storeu_ps(x + i, _mm256_add_ps(cx, _mm256_mul_ps(distance, cosine)));
+					_mm256_storeu_ps(y + i, _mm256_add_ps(cy, _mm256_mul_ps(distance, sine)));
+				}
+				return i;
+			}
+
+			std::size_t rotateSimd(float* x, float* y, std::size_t count, sf::Vector2f direction)
+			{
+				const __m256 dx = _mm256_set1_ps(direction.x);
+				const __m256 dy = _mm256_set1_ps(direction.y);
+
+				std::size_t i = 0;
+				for (; i + 8U <= count; i += 8U)
+				{
+					__m256 sine, cosine;
+					simd::sincos(_mm256_loadu_ps(x + i), sine, cosine);
+					_mm256_storeu_ps(x + i, _mm256_sub_ps(_mm256_mul_ps(cosine, dx), _mm256_mul_ps(sine, dy)));
+					_mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_mul_ps(sine, dx), _mm256_mul_ps(cosine, dy)));
+				}
+				return i;
+			}
+
+#elif defined(PX_SIMD_SSE2)
+
+			std::size_t toDiscSimd(float* x, float* y, std::size_t count, sf::Vector2f center, float radius)
+			{
+				const __m128 cx = _mm_set1_ps(center.x);
+				const __m128 cy = _mm_set1_ps(center.y);
+				const __m128 r = _mm_set1_ps(radius);
+
+				std::size_t i = 0;
+				for (; i + 4U <= count; i += 4U)
+				{
+					__m128 sine, cosine;
+					simd::sincos(_mm_loadu_ps(y + i), sine, cosine);
+					const __m128 distance = _mm_mul_ps(r, _mm_sqrt_ps(_mm_loadu_ps(x + i)));
+					_mm_storeu_ps(x + i, _mm_add_ps(cx, _mm_mul_ps(distance, cosine)));
+					_mm_storeu_ps(y + i, _mm_add_ps(cy, _mm_mul_ps(distance, sine)));
+				}
+				return i;
+			}
+
+			std::size_t rotateSimd(float* x, float* y, std::size_t count, sf::Vector2f direction)
+			{
+				const __m128 dx = _mm_set1_ps(direction.x);
+				const __m128 dy = _mm_set1_ps(direction.y);
+
+				std::size_t i = 0;
+				for (; i + 4U <= count; i += 4U)
+				{
+					__m128 sine, cosine;
+					simd::sincos(_mm_loadu_ps(x + i), sine, cosine);
+					_mm_storeu_ps(x + i, _mm_sub_ps(_mm_mul_ps(cosine, dx), _mm_mul_ps(sine, dy)));
+					_mm_storeu_ps(y + i, _mm_add_ps(_mm_mul_ps(sine, dx), _mm_mul_ps(cosine, dy)));
+				}
+				return i;
+			}
+
+#else
+
+			std::size_t toDiscSimd(float*, float*, std::size_t, sf::Vector2f, float)
+			{
+				return 0U;
+			}
+
+			std::size_t rotateSimd(float*, float*, std::size_t, sf::Vector2f)
+			{
+				return 0U;
+			}
+
+#endif
+		}
+
+		void point(float* x, float* y, std::size_t count, sf::Vector2f center)
+		{
+			std::fill_n(x, count, center.x);
+			std::fill_n(y, count, center.y);
+		}
+
+		void rect(Random & random, float* x, float* y, std::size_t count, sf::Vector2f center, sf::Vector2f halfSize)
+		{
+			random.fill(x, count, center.x - halfSize.x, center.x + halfSize.x);
+			random.fill(y, count, center.y - halfSize.y, center.y + halfSize.y);
+		}
+
+		void circle(Random & random, float* x, float* y, std::size_t count, sf::Vector2f center, float radius)
+		{
+			// Draw the distance and the angle into the output arrays, then turn them into points.
+			// The square root keeps the points uniform over the disc area
+			random.fill(x, count);
+			random.fill(y, count, 0.f, 360.f * degToRad);
+			toDisc(x, y, toDiscSimd(x, y, count, center, radius), count, center, radius);
+		}
+
+		void deflect(Random & random, float* x, float* y, std::size_t count, sf::Vector2f direction, float maxRotation)
+		{
+			random.fill(x, count, -maxRotation * degToRad, maxRotation * degToRad);
+			rotate(x, y, rotateSimd(x, y, count, direction), count, direction);
+		}
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+namespace px
+{
+	class Random;
+
+	// Batch samplers, each writes count x and y components into the given SoA arrays.
+	// Angles go through simd::sincos, so every instruction set produces the same values
+	namespace Distributions
+	{
+		void point(float* x, float* y, std::size_t count, sf::Vector2f center);
+		void rect(Random & random, float* x, float* y, std::size_t count, sf::Vector2f center, sf::Vector2f halfSize);
+
+		// Uniform over the disc area
+		void circle(Random & random, float* x, float* y, std::size_t count, sf::Vector2f center, float radius);
+
+		// Rotates direction by up to maxRotation degrees in both directions
+		void deflect(Random & random, float* x, float* y, std::size_t count, sf::Vector2f direction, float maxRotation);
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <particles/ParticleStore.hpp>
+#include <Thor/Particles/EmissionInterface.hpp>
+
+namespace px
+{
+	// Interface emitters use to add particles to a system. Thor emitters keep emitting one
+	// particle at a time through emitParticle, px emitters reserve whole batches
+	class EmissionInterface : public thor::EmissionInterface
+	{
+	public:
+		virtual ~EmissionInterface() = default;
+
+		// Append up to count particles with default attributes and return the index of the first one.
+		// A system at its capacity may append fewer, the new slots always end at the end of the store.
+		// The caller fills them attribute by attribute through getParticleStore()
+		virtual std::size_t emitParticles(std::size_t count) = 0;
+		virtual ParticleStore & getParticleStore() = 0;
+	};
+}
@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Emitters.hpp"
+#include <utils/FloatingPoint.hpp>
+#include <algorithm>
+
+namespace px
+{
+	EmitterCore::EmitterCore() : m_random(makeSeed()), m_emissionRate(1.f), m_emissionDifference(0.f),
+		m_lifetime(1.f, 1.f), m_scale(1.f, 1.f), m_rotation(0.f, 0.f), m_rotationSpeed(0.f, 0.f), m_color(sf::Color::White),
+		m_subframeEmission(true)
+	{
+	}
+
+	void EmitterCore::seed(std::uint64_t seed)
+	{
+		m_random.seed(seed);
+	}
+
+	void EmitterCore::setEmissionRate(float particlesPerSecond)
+	{
+		m_emissionRate = particlesPerSecond;
+	}
+
+	void EmitterCore::setParticleLifetime(sf::Time min, sf::Time max)
+	{
+		m_lifetime = sf::Vector2f(min.asSeconds(), max.asSeconds());
+	}
+
+	void EmitterCore::setParticleScale(float min, float max)
+	{
+		m_scale = sf::Vector2f(min, max);
+	}
+
+	void EmitterCore::setParticleRotation(float min, float max)
+	{
+		m_rotation = sf::Vector2f(min, max);
+	}
+
+	void EmitterCore::setParticleRotationSpeed(float min, float max)
+	{
+		m_rotationSpeed = sf::Vector2f(min, max);
+	}
+
+	void EmitterCore::setParticleColor(const sf::Color & color)
+	{
+		m_color = color;
+	}
+
+	void EmitterCore::setSubframeEmission(bool enabled)
+	{
+		m_subframeEmission = enabled;
+	}
+
+	// Carry the fractional part over to the next frame, so the rate is met on average
+	std::size_t EmitterCore::computeParticleCount(sf::Time dt)
+	{
+		const float particleAmount = m_emissionRate * dt.asSeconds() + m_emissionDifference;
+		const std::size_t count = static_cast<std::size_t>(particleAmount);
+
+		m_emissionDifference = particleAmount - static_cast<float>(count);
+		return count;
+	}
+
+	void EmitterCore::emitAttributes(ParticleStore & particles, std::size_t first, std::size_t count)
+	{
+		m_random.fill(&particles.totalLifetime[first], count, m_lifetime.x, m_lifetime.y);
+		m_random.fill(&particles.rotation[first], count, m_rotation.x, m_rotation.y);
+		m_random.fill(&particles.rotationSpeed[first], count, m_rotationSpeed.x, m_rotationSpeed.y);
+		m_random.fill(&particles.scaleX[first], count, m_scale.x, m_scale.y);
+		std::copy_n(&particles.scaleX[first], count, &particles.scaleY[first]);
+		std::fill_n(&particles.color[first], count, m_color);
+	}
+
+	// Every particle gets an emission moment within the frame. The system integrates the whole frame after
+	// emitting, so a particle is moved back by the part of the frame that passed before its moment
+	void EmitterCore::spreadOverFrame(ParticleStore & particles, std::size_t first, std::size_t count, sf::Time dt)
+	{
+		if (!m_subframeEmission)
+			return;
+
+		float* passedLifetime = &particles.passedLifetime[first];
+		m_random.fill(passedLifetime, count, -dt.asSeconds(), 0.f);
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			particles.positionX[first + i] += particles.velocityX[first + i] * passedLifetime[i];
+			particles.positionY[first + i] += particles.velocityY[first + i] * passedLifetime[i];
+			particles.rotation[first + i] += particles.rotationSpeed[first + i] * passedLifetime[i];
+		}
+	}
+
+	UniversalEmitter::UniversalEmitter() : m_velocity(0.f, 0.f), m_maxRotation(0.f), m_shape(EmitterShape::None),
+		m_center(0.f, 0.f), m_radius(0.f), m_halfSize(0.f, 0.f)
+	{
+	}
+
+	// A single dispatch per frame, the emission itself runs inside the specialization
+	void UniversalEmitter::operator()(EmissionInterface & system, sf::Time dt)
+	{
+		std::visit([&](auto & emitter) { emitter(system, dt); }, m_emitter);
+	}
+
+	void UniversalEmitter::seed(std::uint64_t seed)
+	{
+		getCore().seed(seed);
+	}
+
+	void UniversalEmitter::setEmissionRate(float particlesPerSecond)
+	{
+		getCore().setEmissionRate(particlesPerSecond);
+	}
+
+	void UniversalEmitter::setParticleLifetime(sf::Time min, sf::Time max)
+	{
+		getCore().setParticleLifetime(min, max);
+	}
+
+	void UniversalEmitter::setParticleScale(float min, float max)
+	{
+		getCore().setParticleScale(min, max);
+	}
+
+	void UniversalEmitter::setParticleRotation(float min, float max)
+	{
+		getCore().setParticleRotation(min, max);
+	}
+
+	void UniversalEmitter::setParticleRotationSpeed(float min, float max)
+	{
+		getCore().setParticleRotationSpeed(min, max);
+	}
+
+	void UniversalEmitter::setParticleColor(const sf::Color & color)
+	{
+		getCore().setParticleColor(color);
+	}
+
+	void UniversalEmitter::setSubframeEmission(bool enabled)
+	{
+		getCore().setSubframeEmission(enabled);
+	}
+
+	void UniversalEmitter::setParticleVelocity(sf::Vector2f velocity, float maxRotation)
+	{
+		m_velocity = velocity;
+		m_maxRotation = maxRotation;
+		specialize();
+	}
+
+	void UniversalEmitter::setParticlePosition(EmitterShape shape, sf::Vector2f center, float radius, sf::Vector2f halfSize)
+	{
+		m_shape = shape;
+		m_center = center;
+		m_radius = radius;
+		m_halfSize = halfSize;
+		specialize();
+	}
+
+	EmitterCore & UniversalEmitter::getCore()
+	{
+		return std::visit([](auto & emitter) -> EmitterCore & { return emitter; }, m_emitter);
+	}
+
+	void UniversalEmitter::specialize()
+	{
+		switch (m_shape)
+		{
+		case EmitterShape::Circle:
+			specialize(CircleShape{ m_center, m_radius });
+			break;
+		case EmitterShape::Rectangle:
+			specialize(RectangleShape{ m_center, m_halfSize });
+			break;
+		default:
+			specialize(PointShape{ m_center });
+			break;
+		}
+	}
+
+	// The new specialization takes over the core, so the random stream and the emission remainder carry on
+	template <typename ShapePolicy>
+	void UniversalEmitter::specialize(ShapePolicy shape)
+	{
+		const EmitterCore core = getCore();
+
+		if (m_maxRotation == 0.f)
+			m_emitter = Emitter<ShapePolicy, FixedVelocity>(core, shape, FixedVelocity{ m_velocity });
+		else
+			m_emitter = Emitter<ShapePolicy, DeflectedVelocity>(core, shape, DeflectedVelocity{ m_velocity, m_maxRotation });
+	}
+}
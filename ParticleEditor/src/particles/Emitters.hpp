@@ -0,0 +1,209 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <particles/Distributions.hpp>
+#include <particles/EmissionInterface.hpp>
+#include <utils/Random.hpp>
+#include <functional>
+#include <variant>
+
+namespace px
+{
+	enum class EmitterShape
+	{
+		None,
+		Circle,
+		Rectangle
+	};
+
+	// Wraps a reference to an emitter, the emitter must outlive the returned function
+	template <typename Emitter>
+	std::function<void(EmissionInterface &, sf::Time)> refEmitter(Emitter & referenced)
+	{
+		return [&referenced](EmissionInterface & system, sf::Time dt)
+		{
+			referenced(system, dt);
+		};
+	}
+
+	// Shape policies, they write the positions of a batch
+	struct PointShape
+	{
+		void operator()(Random &, float* x, float* y, std::size_t count) const
+		{
+			Distributions::point(x, y, count, center);
+		}
+
+		sf::Vector2f center;
+	};
+
+	struct CircleShape
+	{
+		void operator()(Random & random, float* x, float* y, std::size_t count) const
+		{
+			Distributions::circle(random, x, y, count, center, radius);
+		}
+
+		sf::Vector2f center;
+		float radius;
+	};
+
+	struct RectangleShape
+	{
+		void operator()(Random & random, float* x, float* y, std::size_t count) const
+		{
+			Distributions::rect(random, x, y, count, center, halfSize);
+		}
+
+		sf::Vector2f center;
+		sf::Vector2f halfSize;
+	};
+
+	// Velocity policies, they write the velocities of a batch. Polar velocities are
+	// converted to cartesian ones before they reach a policy
+	struct FixedVelocity
+	{
+		void operator()(Random &, float* x, float* y, std::size_t count) const
+		{
+			Distributions::point(x, y, count, velocity);
+		}
+
+		sf::Vector2f velocity;
+	};
+
+	struct DeflectedVelocity
+	{
+		void operator()(Random & random, float* x, float* y, std::size_t count) const
+		{
+			Distributions::deflect(random, x, y, count, velocity, maxRotation);
+		}
+
+		sf::Vector2f velocity;
+		float maxRotation;
+	};
+
+	// Attributes shared by every emitter: rate, the uniform ranges, color and the random stream
+	class EmitterCore
+	{
+	public:
+		EmitterCore();
+
+	public:
+		void seed(std::uint64_t seed);
+		void setEmissionRate(float particlesPerSecond);
+
+		// Uniform ranges, the scale applies the same factor to both axes
+		void setParticleLifetime(sf::Time min, sf::Time max);
+		void setParticleScale(float min, float max);
+		void setParticleRotation(float min, float max);
+		void setParticleRotationSpeed(float min, float max);
+		void setParticleColor(const sf::Color & color);
+
+		// Spread the emission moments of a frame's particles over the frame instead of emitting them all
+		// at its start, so large frame times do not emit them in visible shells. Enabled by default
+		void setSubframeEmission(bool enabled);
+
+	protected:
+		std::size_t computeParticleCount(sf::Time dt);
+		void emitAttributes(ParticleStore & particles, std::size_t first, std::size_t count);
+		void spreadOverFrame(ParticleStore & particles, std::size_t first, std::size_t count, sf::Time dt);
+
+	protected:
+		Random m_random;
+		float m_emissionRate;
+		float m_emissionDifference;
+		sf::Vector2f m_lifetime;
+		sf::Vector2f m_scale;
+		sf::Vector2f m_rotation;
+		sf::Vector2f m_rotationSpeed;
+		sf::Color m_color;
+		bool m_subframeEmission;
+	};
+
+	// Emitter with its shape and velocity fixed at compile time. Every frame it reserves all of its
+	// particles in one batch and fills them attribute by attribute, without any indirect calls
+	template <typename ShapePolicy, typename VelocityPolicy>
+	class Emitter : public EmitterCore
+	{
+	public:
+		Emitter(const EmitterCore & core = EmitterCore(), ShapePolicy shape = ShapePolicy(),
+			VelocityPolicy velocity = VelocityPolicy()) : EmitterCore(core), m_shape(shape), m_velocity(velocity)
+		{
+		}
+
+		void operator()(EmissionInterface & system, sf::Time dt)
+		{
+			std::size_t count = computeParticleCount(dt);
+			if (count == 0U)
+				return;
+
+			const std::size_t first = system.emitParticles(count);
+			ParticleStore & particles = system.getParticleStore();
+			count = particles.size() - first;
+			if (count == 0U)
+				return;
+
+			emitAttributes(particles, first, count);
+			m_shape(m_random, &particles.positionX[first], &particles.positionY[first], count);
+			m_velocity(m_random, &particles.velocityX[first], &particles.velocityY[first], count);
+			spreadOverFrame(particles, first, count, dt);
+		}
+
+	public:
+		ShapePolicy & getShape() { return m_shape; }
+		VelocityPolicy & getVelocity() { return m_velocity; }
+
+	private:
+		ShapePolicy m_shape;
+		VelocityPolicy m_velocity;
+	};
+
+	// Emitter with the distributions the editor offers. It holds the Emitter specialization matching
+	// the current shape and deflection and switches to another one when those change
+	class UniversalEmitter
+	{
+	public:
+		UniversalEmitter();
+		void operator()(EmissionInterface & system, sf::Time dt);
+
+	public:
+		void seed(std::uint64_t seed);
+		void setEmissionRate(float particlesPerSecond);
+		void setParticleLifetime(sf::Time min, sf::Time max);
+		void setParticleScale(float min, float max);
+		void setParticleRotation(float min, float max);
+		void setParticleRotationSpeed(float min, float max);
+		void setParticleColor(const sf::Color & color);
+		void setSubframeEmission(bool enabled);
+
+		// Deflection rotates the velocity by up to maxRotation degrees, zero disables it
+		void setParticleVelocity(sf::Vector2f velocity, float maxRotation = 0.f);
+
+		// Circle uses radius, Rectangle uses halfSize and None emits from the center only
+		void setParticlePosition(EmitterShape shape, sf::Vector2f center, float radius = 0.f,
+			sf::Vector2f halfSize = sf::Vector2f(0.f, 0.f));
+
+	private:
+		using Specialization = std::variant<
+			Emitter<PointShape, FixedVelocity>, Emitter<PointShape, DeflectedVelocity>,
+			Emitter<CircleShape, FixedVelocity>, Emitter<CircleShape, DeflectedVelocity>,
+			Emitter<RectangleShape, FixedVelocity>, Emitter<RectangleShape, DeflectedVelocity>>;
+
+		EmitterCore & getCore();
+		void specialize();
+
+		template <typename ShapePolicy>
+		void specialize(ShapePolicy shape);
+
+	private:
+		Specialization m_emitter;
+		sf::Vector2f m_velocity;
+		float m_maxRotation;
+		EmitterShape m_shape;
+		sf::Vector2f m_center;
+		float m_radius;
+		sf::Vector2f m_halfSize;
+	};
+}
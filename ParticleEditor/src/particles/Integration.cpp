@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Integration.hpp"
+
+namespace px
+{
+	namespace
+	{
+		struct Streams
+		{
+			float* positionX;
+			float* positionY;
+			float* rotation;
+			float* passedLifetime;
+			const float* velocityX;
+			const float* velocityY;
+			const float* rotationSpeed;
+		};
+
+		Streams streams(ParticleStore & particles)
+		{
+			return { particles.positionX.data(), particles.positionY.data(), particles.rotation.data(),
+				particles.passedLifetime.data(), particles.velocityX.data(), particles.velocityY.data(),
+				particles.rotationSpeed.data() };
+		}
+
+		// Multiply and add are kept as separate operations in every kernel (no fused multiply-add),
+		// so all paths round identically
+		void integrateRange(const Streams & s, std::size_t begin, std::size_t end, float dt)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				s.positionX[i] += s.velocityX[i] * dt;
+				s.positionY[i] += s.velocityY[i] * dt;
+				s.rotation[i] += s.rotationSpeed[i] * dt;
+				s.passedLifetime[i] += dt;
+			}
+		}
+	}
+
+	void advanceLifetime(ParticleStore & particles, std::size_t begin, std::size_t end, float dt)
+	{
+		float* passedLifetime = particles.passedLifetime.data();
+		for (std::size_t i = begin; i < end; ++i)
+			passedLifetime[i] += dt;
+	}
+
+	void integrateScalar(ParticleStore & particles, std::size_t begin, std::size_t end, float dt)
+	{
+		integrateRange(streams(particles), begin, end, dt);
+	}
+
+#if defined(PX_SIMD_AVX2)
+
+	void integrate(ParticleStore & particles, std::size_t begin, std::size_t end, float dt)
+	{
+		const Streams s = streams(particles);
+		const __m256 step = _mm256_set1_ps(dt);
+
+		std::size_t i = begin;
+		for (; i + 8U <= end; i += 8U)
+		{
+			const __m256 px = _mm256_loadu_ps(s.positionX + i);
+			const __m256 py = _mm256_loadu_ps(s.positionY + i);
+			const __m256 r = _mm256_loadu_ps(s.rotation + i);
+			const __m256 t = _mm256_loadu_ps(s.passedLifetime + i);
+
+			_mm256_storeu_ps(s.positionX + i, _mm256_add_ps(px, _mm256_mul_ps(_mm256_loadu_ps(s.velocityX + i), step)));
+			_mm256_storeu_ps(s.positionY + i, _mm256_add_ps(py, _mm256_mul_ps(_mm256_loadu_ps(s.velocityY + i), step)));
+			_mm256_storeu_ps(s.rotation + i, _mm256_add_ps(r, _mm256_mul_ps(_mm256_loadu_ps(s.rotationSpeed + i), step)));
+			_mm256_storeu_ps(s.passedLifetime + i, _mm256_add_ps(t, step));
+		}
+
+		integrateRange(s, i, end, dt);
+	}
+
+#elif defined(PX_SIMD_SSE2)
+
+	void integrate(ParticleStore & particles, std::size_t begin, std::size_t end, float dt)
+	{
+		const Streams s = streams(particles);
+		const __m128 step = _mm_set1_ps(dt);
+
+		std::size_t i = begin;
+		for (; i + 4U <= end; i += 4U)
+		{
+			const __m128 px = _mm_loadu_ps(s.positionX + i);
+			const __m128 py = _mm_loadu_ps(s.positionY + i);
+			const __m128 r = _mm_loadu_ps(s.rotation + i);
+			const __m128 t = _mm_loadu_ps(s.passedLifetime + i);
+
+			_mm_storeu_ps(s.positionX + i, _mm_add_ps(px, _mm_mul_ps(_mm_loadu_ps(s.velocityX + i), step)));
+			_mm_storeu_ps(s.positionY + i, _mm_add_ps(py, _mm_mul_ps(_mm_loadu_ps(s.velocityY + i), step)));
+			_mm_storeu_ps(s.rotation + i, _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(s.rotationSpeed + i), step)));
+			_mm_storeu_ps(s.passedLifetime + i, _mm_add_ps(t, step));
+		}
+
+		integrateRange(s, i, end, dt);
+	}
+
+#else
+
+	void integrate(ParticleStore & particles, std::size_t begin, std::size_t end, float dt)
+	{
+		integrateRange(streams(particles), begin, end, dt);
+	}
+
+#endif
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <particles/ParticleStore.hpp>
+#include <particles/Simd.hpp>
+
+namespace px
+{
+	// Advance position, rotation and passed lifetime of the particles in [begin, end) by dt seconds
+	void integrate(ParticleStore & particles, std::size_t begin, std::size_t end, float dt);
+
+	// Advance only the passed lifetime, for particles whose state is evaluated from their age
+	void advanceLifetime(ParticleStore & particles, std::size_t begin, std::size_t end, float dt);
+
+	// Reference kernel, produces the same results as the vectorized one
+	void integrateScalar(ParticleStore & particles, std::size_t begin, std::size_t end, float dt);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+
+namespace px
+{
+	// Single particle, used when a particle has to be handed out by value (e.g. to custom affectors).
+	// The particle system itself stores particles attribute by attribute, see ParticleStore
+	struct Particle
+	{
+		sf::Vector2f position = sf::Vector2f(0.f, 0.f);
+		sf::Vector2f velocity = sf::Vector2f(0.f, 0.f);
+		float rotation = 0.f;
+		float rotationSpeed = 0.f;
+		sf::Vector2f scale = sf::Vector2f(1.f, 1.f);
+		sf::Color color = sf::Color::White;
+		unsigned int textureIndex = 0U;
+		sf::Time passedLifetime = sf::Time::Zero;
+		sf::Time totalLifetime = sf::seconds(1.f);
+	};
+
+	// Ratio of the lifetime that has already passed, in [0, 1]
+	inline float getElapsedRatio(const Particle & particle)
+	{
+		return particle.passedLifetime.asSeconds() / particle.totalLifetime.asSeconds();
+	}
+
+	inline float getRemainingRatio(const Particle & particle)
+	{
+		return 1.f - getElapsedRatio(particle);
+	}
+}
@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "ParticleStore.hpp"
+#include <algorithm>
+
+namespace px
+{
+	std::size_t ParticleStore::size() const
+	{
+		return positionX.size();
+	}
+
+	bool ParticleStore::empty() const
+	{
+		return positionX.empty();
+	}
+
+	void ParticleStore::reserve(std::size_t capacity)
+	{
+		positionX.reserve(capacity);
+		positionY.reserve(capacity);
+		velocityX.reserve(capacity);
+		velocityY.reserve(capacity);
+		rotation.reserve(capacity);
+		rotationSpeed.reserve(capacity);
+		scaleX.reserve(capacity);
+		scaleY.reserve(capacity);
+		passedLifetime.reserve(capacity);
+		totalLifetime.reserve(capacity);
+		color.reserve(capacity);
+		textureIndex.reserve(capacity);
+		previousPositionX.reserve(capacity);
+		previousPositionY.reserve(capacity);
+		previousRotation.reserve(capacity);
+	}
+
+	void ParticleStore::clear()
+	{
+		truncate(0U);
+	}
+
+	std::size_t ParticleStore::grow(std::size_t count)
+	{
+		const std::size_t first = size();
+		const std::size_t last = first + count;
+
+		positionX.resize(last, 0.f);
+		positionY.resize(last, 0.f);
+		velocityX.resize(last, 0.f);
+		velocityY.resize(last, 0.f);
+		rotation.resize(last, 0.f);
+		rotationSpeed.resize(last, 0.f);
+		scaleX.resize(last, 1.f);
+		scaleY.resize(last, 1.f);
+		passedLifetime.resize(last, 0.f);
+		totalLifetime.resize(last, 1.f);
+		color.resize(last, sf::Color::White);
+		textureIndex.resize(last, 0U);
+		previousPositionX.resize(last, 0.f);
+		previousPositionY.resize(last, 0.f);
+		previousRotation.resize(last, 0.f);
+
+		return first;
+	}
+
+	void ParticleStore::truncate(std::size_t count)
+	{
+		if (count >= size())
+			return;
+
+		positionX.resize(count);
+		positionY.resize(count);
+		velocityX.resize(count);
+		velocityY.resize(count);
+		rotation.resize(count);
+		rotationSpeed.resize(count);
+		scaleX.resize(count);
+		scaleY.resize(count);
+		passedLifetime.resize(count);
+		totalLifetime.resize(count);
+		color.resize(count);
+		textureIndex.resize(count);
+		previousPositionX.resize(count);
+		previousPositionY.resize(count);
+		previousRotation.resize(count);
+	}
+
+	void ParticleStore::move(std::size_t from, std::size_t to)
+	{
+		positionX[to] = positionX[from];
+		positionY[to] = positionY[from];
+		velocityX[to] = velocityX[from];
+		velocityY[to] = velocityY[from];
+		rotation[to] = rotation[from];
+		rotationSpeed[to] = rotationSpeed[from];
+		scaleX[to] = scaleX[from];
+		scaleY[to] = scaleY[from];
+		passedLifetime[to] = passedLifetime[from];
+		totalLifetime[to] = totalLifetime[from];
+		color[to] = color[from];
+		textureIndex[to] = textureIndex[from];
+		previousPositionX[to] = previousPositionX[from];
+		previousPositionY[to] = previousPositionY[from];
+		previousRotation[to] = previousRotation[from];
+	}
+
+	void ParticleStore::moveRange(std::size_t from, std::size_t count, std::size_t to)
+	{
+		auto moveAttribute = [=](auto & attribute)
+		{
+			std::copy(attribute.begin() + from, attribute.begin() + from + count, attribute.begin() + to);
+		};
+
+		moveAttribute(positionX);
+		moveAttribute(positionY);
+		moveAttribute(velocityX);
+		moveAttribute(velocityY);
+		moveAttribute(rotation);
+		moveAttribute(rotationSpeed);
+		moveAttribute(scaleX);
+		moveAttribute(scaleY);
+		moveAttribute(passedLifetime);
+		moveAttribute(totalLifetime);
+		moveAttribute(color);
+		moveAttribute(textureIndex);
+		moveAttribute(previousPositionX);
+		moveAttribute(previousPositionY);
+		moveAttribute(previousRotation);
+	}
+
+	void ParticleStore::savePreviousState(std::size_t begin, std::size_t end)
+	{
+		std::copy(positionX.begin() + begin, positionX.begin() + end, previousPositionX.begin() + begin);
+		std::copy(positionY.begin() + begin, positionY.begin() + end, previousPositionY.begin() + begin);
+		std::copy(rotation.begin() + begin, rotation.begin() + end, previousRotation.begin() + begin);
+	}
+
+	Particle ParticleStore::get(std::size_t index) const
+	{
+		Particle particle;
+		particle.position = sf::Vector2f(positionX[index], positionY[index]);
+		particle.velocity = sf::Vector2f(velocityX[index], velocityY[index]);
+		particle.rotation = rotation[index];
+		particle.rotationSpeed = rotationSpeed[index];
+		particle.scale = sf::Vector2f(scaleX[index], scaleY[index]);
+		particle.color = color[index];
+		particle.textureIndex = textureIndex[index];
+		particle.passedLifetime = sf::seconds(passedLifetime[index]);
+		particle.totalLifetime = sf::seconds(totalLifetime[index]);
+		return particle;
+	}
+
+	void ParticleStore::set(std::size_t index, const Particle & particle)
+	{
+		positionX[index] = particle.position.x;
+		positionY[index] = particle.position.y;
+		velocityX[index] = particle.velocity.x;
+		velocityY[index] = particle.velocity.y;
+		rotation[index] = particle.rotation;
+		rotationSpeed[index] = particle.rotationSpeed;
+		scaleX[index] = particle.scale.x;
+		scaleY[index] = particle.scale.y;
+		color[index] = particle.color;
+		textureIndex[index] = particle.textureIndex;
+		passedLifetime[index] = particle.passedLifetime.asSeconds();
+		totalLifetime[index] = particle.totalLifetime.asSeconds();
+	}
+}
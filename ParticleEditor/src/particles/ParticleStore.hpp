@@ -0,0 +1,60 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <particles/Particle.hpp>
+#include <vector>
+
+namespace px
+{
+	// Structure-of-arrays particle storage. Every attribute lives in its own contiguous array,
+	// so a pass over the particles only streams the attributes it actually touches
+	class ParticleStore
+	{
+	public:
+		std::size_t size() const;
+		bool empty() const;
+		void reserve(std::size_t capacity);
+		void clear();
+
+		// Append count default particles and return the index of the first one
+		std::size_t grow(std::size_t count);
+
+		// Drop every particle from index count and onwards
+		void truncate(std::size_t count);
+
+		// Copy all attributes of the particle at index from to the slot at index to
+		void move(std::size_t from, std::size_t to);
+
+		// Copy count particles starting at index from down to the slots starting at index to (to <= from)
+		void moveRange(std::size_t from, std::size_t count, std::size_t to);
+
+		// Remember position and rotation of the particles in [begin, end) as their state before the next step
+		void savePreviousState(std::size_t begin, std::size_t end);
+
+	public:
+		// Gather and scatter a single particle
+		Particle get(std::size_t index) const;
+		void set(std::size_t index, const Particle & particle);
+
+	public:
+		std::vector<float> positionX;
+		std::vector<float> positionY;
+		std::vector<float> velocityX;
+		std::vector<float> velocityY;
+		std::vector<float> rotation;
+		std::vector<float> rotationSpeed;
+		std::vector<float> scaleX;
+		std::vector<float> scaleY;
+		std::vector<float> passedLifetime; // In seconds
+		std::vector<float> totalLifetime; // In seconds
+		std::vector<sf::Color> color;
+		std::vector<unsigned int> textureIndex;
+
+		// Position and rotation before the last fixed step, drawing interpolates from them
+		std::vector<float> previousPositionX;
+		std::vector<float> previousPositionY;
+		std::vector<float> previousRotation;
+	};
+}
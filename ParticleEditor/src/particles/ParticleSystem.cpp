@@ -0,0 +1,701 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "ParticleSystem.hpp"
+#include <particles/Integration.hpp>
+#include <utils/ThreadPool.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <Thor/Input/Detail/ConnectionImpl.hpp>
+#include <Thor/Particles/Particle.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace px
+{
+	namespace
+	{
+		// Particles per chunk of a parallel update
+		const std::size_t chunkSize = 8192U;
+
+		// No emitted batch waits to be turned into spawn states
+		const std::size_t noBatch = std::numeric_limits<std::size_t>::max();
+
+		unsigned int nextFunctionId()
+		{
+			static unsigned int next = 0U;
+			return next++;
+		}
+
+		// Remove every function whose time until removal ran out this frame
+		template <typename Container>
+		void incrementalRemove(Container & container, sf::Time dt)
+		{
+			auto expired = std::remove_if(container.begin(), container.end(), [dt](typename Container::value_type & f)
+			{
+				if (f.timeUntilRemoval == sf::Time::Zero)
+					return false;
+
+				f.timeUntilRemoval -= dt;
+				return f.timeUntilRemoval <= sf::Time::Zero;
+			});
+
+			container.modified |= expired != container.end();
+			container.erase(expired, container.end());
+		}
+	}
+
+	// Like thor's IdConnectionImpl, but the container can be replaced when it moves
+	template <typename Function>
+	class ParticleSystem::EntryConnection : public thor::detail::AbstractConnectionImpl
+	{
+	public:
+		EntryConnection(EntryContainer<Function> & container, unsigned int id) : m_container(&container), m_id(id)
+		{
+		}
+
+		virtual void disconnect() override
+		{
+			auto found = std::find_if(m_container->begin(), m_container->end(), [this](const Entry<Function> & entry)
+			{
+				return entry.id == m_id;
+			});
+
+			if (found != m_container->end())
+			{
+				m_container->erase(found);
+				m_container->modified = true;
+			}
+		}
+
+		void setContainer(EntryContainer<Function> & container)
+		{
+			m_container = &container;
+		}
+
+	private:
+		EntryContainer<Function> * m_container;
+		unsigned int m_id;
+	};
+
+	template <typename Function>
+	ParticleSystem::Entry<Function>::Entry(Function function, sf::Time timeUntilRemoval) :
+		function(std::move(function)), timeUntilRemoval(timeUntilRemoval), id(nextFunctionId()), tracker()
+	{
+	}
+
+	template <typename Function>
+	ParticleSystem::EntryContainer<Function>::EntryContainer(EntryContainer && other) : std::vector<Entry<Function>>(std::move(other)),
+		modified(other.modified)
+	{
+		retarget();
+	}
+
+	template <typename Function>
+	ParticleSystem::EntryContainer<Function> & ParticleSystem::EntryContainer<Function>::operator=(EntryContainer && other)
+	{
+		std::vector<Entry<Function>>::operator=(std::move(other));
+		modified = other.modified;
+		retarget();
+		return *this;
+	}
+
+	template <typename Function>
+	void ParticleSystem::EntryContainer<Function>::retarget()
+	{
+		for (auto & entry : *this)
+			entry.tracker->setContainer(*this);
+	}
+
+	template <typename Function>
+	thor::Connection ParticleSystem::add(EntryContainer<Function> & container, Function function, sf::Time timeUntilRemoval)
+	{
+		container.emplace_back(std::move(function), timeUntilRemoval);
+		container.modified = true;
+		container.back().tracker = std::make_shared<EntryConnection<Function>>(container, container.back().id);
+		return thor::Connection(container.back().tracker);
+	}
+
+	ParticleSystem::ParticleSystem() : m_threadPool(nullptr), m_removalMode(RemovalMode::Stable), m_capacity(0U),
+		m_evictionPolicy(EvictionPolicy::DropNew), m_timestep(sf::Time::Zero), m_accumulator(sf::Time::Zero), m_maxSubsteps(8U),
+		m_evaluationMode(EvaluationMode::Integrated), m_closedForm(false), m_emittedBatch(noBatch), m_texture(nullptr),
+		m_quadSize(0U, 0U), m_needsVertexUpdate(true)
+	{
+	}
+
+	// Every member moves as is, the entry containers take their connections along
+	ParticleSystem::ParticleSystem(ParticleSystem && other) = default;
+	ParticleSystem & ParticleSystem::operator=(ParticleSystem && other) = default;
+
+	void ParticleSystem::setTexture(const sf::Texture & texture)
+	{
+		m_texture = &texture;
+		m_needsVertexUpdate = true;
+	}
+
+	thor::Connection ParticleSystem::addAffector(const ForceAffector & affector, sf::Time timeUntilRemoval)
+	{
+		return add(m_builtinAffectors, BuiltinAffector(affector), timeUntilRemoval);
+	}
+
+	thor::Connection ParticleSystem::addAffector(const TorqueAffector & affector, sf::Time timeUntilRemoval)
+	{
+		return add(m_builtinAffectors, BuiltinAffector(affector), timeUntilRemoval);
+	}
+
+	thor::Connection ParticleSystem::addAffector(const FadeAffector & affector, sf::Time timeUntilRemoval)
+	{
+		return add(m_builtinAffectors, BuiltinAffector(affector), timeUntilRemoval);
+	}
+
+	thor::Connection ParticleSystem::addAffector(const ScaleAffector & affector, sf::Time timeUntilRemoval)
+	{
+		return add(m_builtinAffectors, BuiltinAffector(affector), timeUntilRemoval);
+	}
+
+	thor::Connection ParticleSystem::addAffector(const ColorAffector & affector, sf::Time timeUntilRemoval)
+	{
+		return add(m_builtinAffectors, BuiltinAffector(affector), timeUntilRemoval);
+	}
+
+	thor::Connection ParticleSystem::addAffector(Affector affector, sf::Time timeUntilRemoval)
+	{
+		return add(m_affectors, std::move(affector), timeUntilRemoval);
+	}
+
+	thor::Connection ParticleSystem::addEmitter(Emitter emitter, sf::Time timeUntilRemoval)
+	{
+		return add(m_emitters, std::move(emitter), timeUntilRemoval);
+	}
+
+	void ParticleSystem::clearAffectors()
+	{
+		m_builtinAffectors.clear();
+		m_builtinAffectors.modified = true;
+		m_affectors.clear();
+	}
+
+	void ParticleSystem::clearEmitters()
+	{
+		m_emitters.clear();
+	}
+
+	void ParticleSystem::setThreadPool(ThreadPool * pool)
+	{
+		m_threadPool = pool;
+	}
+
+	void ParticleSystem::setRemovalMode(RemovalMode mode)
+	{
+		m_removalMode = mode;
+	}
+
+	void ParticleSystem::setCapacity(std::size_t capacity, EvictionPolicy policy)
+	{
+		m_capacity = capacity;
+		m_evictionPolicy = policy;
+
+		if (m_capacity == 0U)
+			return;
+
+		if (m_particles.size() > m_capacity)
+			evictParticles(m_particles.size() - m_capacity, policy);
+
+		m_particles.reserve(m_capacity);
+		m_evaluated.reserve(m_capacity);
+		m_evictionKeys.reserve(m_capacity);
+		m_evictionOrder.reserve(m_capacity);
+		m_chunkSurvivors.reserve((m_capacity + chunkSize - 1U) / chunkSize);
+		m_vertices.reserve(m_capacity * 4U);
+	}
+
+	void ParticleSystem::setFixedTimestep(sf::Time step, unsigned int maxSubsteps)
+	{
+		m_timestep = step;
+		m_accumulator = sf::Time::Zero;
+		m_maxSubsteps = maxSubsteps;
+		m_particles.savePreviousState(0U, m_particles.size());
+		m_needsVertexUpdate = true;
+	}
+
+	void ParticleSystem::setEvaluationMode(EvaluationMode mode)
+	{
+		m_evaluationMode = mode;
+	}
+
+	void ParticleSystem::clearParticles()
+	{
+		m_particles.clear();
+		m_pendingParticles.clear();
+		m_needsVertexUpdate = true;
+	}
+
+	void ParticleSystem::update(sf::Time dt)
+	{
+		m_needsVertexUpdate = true;
+
+		if (m_timestep == sf::Time::Zero)
+		{
+			simulate(dt);
+			return;
+		}
+
+		m_accumulator += dt;
+		for (unsigned int step = 0; step < m_maxSubsteps && m_accumulator >= m_timestep; ++step)
+		{
+			simulate(m_timestep);
+			m_accumulator -= m_timestep;
+		}
+
+		// A long frame, like one spent in a file dialog, only stalls the effect instead of piling up steps
+		if (m_accumulator >= m_timestep)
+			m_accumulator %= m_timestep;
+	}
+
+	void ParticleSystem::prewarm(sf::Time duration, sf::Time step)
+	{
+		if (step <= sf::Time::Zero)
+			return;
+
+		for (sf::Time elapsed = sf::Time::Zero; elapsed < duration; elapsed += step)
+			simulate(std::min(step, duration - elapsed));
+
+		// The coarse steps are no fixed steps to interpolate from
+		m_particles.savePreviousState(0U, m_particles.size());
+		m_needsVertexUpdate = true;
+	}
+
+	void ParticleSystem::simulate(sf::Time dt)
+	{
+		collectBuiltinAffectors();
+		switchEvaluation();
+
+		// Emit new particles, the emitters may disconnect themselves while being invoked
+		for (std::size_t i = 0; i < m_emitters.size(); ++i)
+			m_emitters[i].function(*this, dt);
+		finishEmission();
+		admitPendingParticles();
+
+		// Every chunk is integrated and compacted on its own, the survivors are merged in chunk order
+		// afterwards so the result does not depend on the number of threads
+		const std::size_t count = m_particles.size();
+		const float seconds = dt.asSeconds();
+		m_chunkSurvivors.resize((count + chunkSize - 1U) / chunkSize);
+
+		if (m_threadPool)
+		{
+			m_threadPool->parallelFor(count, chunkSize, [this, seconds](std::size_t begin, std::size_t end)
+			{
+				updateChunk(begin / chunkSize, begin, end, seconds);
+			});
+		}
+		else
+		{
+			for (std::size_t begin = 0; begin < count; begin += chunkSize)
+				updateChunk(begin / chunkSize, begin, std::min(begin + chunkSize, count), seconds);
+		}
+
+		m_removalMode == RemovalMode::Stable ? mergeChunks() : fillChunkGaps();
+		applyCustomAffectors(dt);
+
+		incrementalRemove(m_emitters, dt);
+		incrementalRemove(m_builtinAffectors, dt);
+		incrementalRemove(m_affectors, dt);
+	}
+
+	std::size_t ParticleSystem::getParticleCount() const
+	{
+		return m_particles.size();
+	}
+
+	const ParticleStore & ParticleSystem::getParticles() const
+	{
+		return m_particles;
+	}
+
+	void ParticleSystem::draw(sf::RenderTarget & target, sf::RenderStates states) const
+	{
+		if (getVertexCount() == 0U)
+			return;
+
+		if (m_needsVertexUpdate || m_texture->getSize() != m_quadSize)
+		{
+			m_vertices.resize(getVertexCount());
+			writeVertices(m_vertices.data());
+			m_needsVertexUpdate = false;
+		}
+
+		states.texture = m_texture;
+		target.draw(m_vertices.data(), m_vertices.size(), sf::Quads, states);
+	}
+
+	// A texture without pixels, like one that failed to load, would only give quads of zero size
+	std::size_t ParticleSystem::getVertexCount() const
+	{
+		const bool hasPixels = m_texture && m_texture->getSize().x > 0U && m_texture->getSize().y > 0U;
+		return hasPixels ? m_particles.size() * 4U : 0U;
+	}
+
+	const sf::Texture * ParticleSystem::getTexture() const
+	{
+		return m_texture;
+	}
+
+	void ParticleSystem::writeVertices(sf::Vertex * vertices) const
+	{
+		if (getVertexCount() == 0U)
+			return;
+
+		if (m_texture->getSize() != m_quadSize)
+			computeQuad();
+
+		if (m_closedForm)
+		{
+			m_evaluated = m_particles;
+
+			// Drawing trails the fixed steps like the interpolation does, the whole state is evaluated at that age
+			const float lag = m_timestep == sf::Time::Zero ? 0.f : (m_timestep - m_accumulator).asSeconds();
+			if (lag > 0.f)
+			{
+				for (float & passedLifetime : m_evaluated.passedLifetime)
+					passedLifetime = std::max(passedLifetime - lag, 0.f);
+			}
+
+			m_affectorSet.evaluate(m_evaluated, 0U, m_evaluated.size(), 1.f);
+			computeVertices(m_evaluated, false, vertices);
+		}
+		else
+			computeVertices(m_particles, m_timestep != sf::Time::Zero, vertices);
+	}
+
+	void ParticleSystem::emitParticle(const thor::Particle & particle)
+	{
+		finishEmission();
+
+		Particle p;
+		p.position = particle.position;
+		p.velocity = particle.velocity;
+		p.rotation = particle.rotation;
+		p.rotationSpeed = particle.rotationSpeed;
+		p.scale = particle.scale;
+		p.color = particle.color;
+		p.textureIndex = particle.textureIndex;
+		p.passedLifetime = thor::getElapsedLifetime(particle);
+		p.totalLifetime = thor::getTotalLifetime(particle);
+
+		// A full system collects the particles and evicts for all of them at once when the emitters are done
+		if (!m_pendingParticles.empty() || (m_capacity != 0U && m_particles.size() >= m_capacity))
+		{
+			if (m_evictionPolicy != EvictionPolicy::DropNew)
+				m_pendingParticles.push_back(p);
+			return;
+		}
+
+		const std::size_t i = m_particles.grow(1U);
+		m_particles.set(i, p);
+
+		if (m_closedForm)
+			m_affectorSet.evaluate(m_particles, i, i + 1U, -1.f);
+	}
+
+	std::size_t ParticleSystem::emitParticles(std::size_t count)
+	{
+		finishEmission();
+		admitPendingParticles();
+		const std::size_t first = m_particles.grow(admitParticles(count));
+
+		if (m_closedForm)
+			m_emittedBatch = first;
+		return first;
+	}
+
+	ParticleStore & ParticleSystem::getParticleStore()
+	{
+		return m_particles;
+	}
+
+	void ParticleSystem::updateChunk(std::size_t chunk, std::size_t begin, std::size_t end, float dt)
+	{
+		if (m_closedForm)
+			advanceLifetime(m_particles, begin, end, dt);
+		else
+		{
+			if (m_timestep != sf::Time::Zero)
+				m_particles.savePreviousState(begin, end);
+			integrate(m_particles, begin, end, dt);
+		}
+		end = m_removalMode == RemovalMode::Stable ? removeDeadParticles(begin, end) : swapDeadParticles(begin, end);
+
+		if (!m_closedForm && !m_affectorSet.empty())
+			m_affectorSet.apply(m_particles, begin, end, dt);
+
+		m_chunkSurvivors[chunk] = end - begin;
+	}
+
+	// Stable compaction within [begin, end), returns the new end of the range
+	std::size_t ParticleSystem::removeDeadParticles(std::size_t begin, std::size_t end)
+	{
+		const float* passedLifetime = m_particles.passedLifetime.data();
+		const float* totalLifetime = m_particles.totalLifetime.data();
+
+		std::size_t writer = begin;
+		for (std::size_t reader = begin; reader < end; ++reader)
+		{
+			if (passedLifetime[reader] < totalLifetime[reader])
+			{
+				if (writer != reader)
+					m_particles.move(reader, writer);
+				++writer;
+			}
+		}
+
+		return writer;
+	}
+
+	// Move the last particle of [begin, end) into every dead slot, returns the new end of the range
+	std::size_t ParticleSystem::swapDeadParticles(std::size_t begin, std::size_t end)
+	{
+		const float* passedLifetime = m_particles.passedLifetime.data();
+		const float* totalLifetime = m_particles.totalLifetime.data();
+
+		std::size_t i = begin;
+		while (i < end)
+		{
+			if (passedLifetime[i] < totalLifetime[i])
+				++i;
+			else if (--end != i)
+				m_particles.move(end, i);
+		}
+
+		return end;
+	}
+
+	// Close the gaps the chunks left behind, the draw order of the surviving particles is kept
+	void ParticleSystem::mergeChunks()
+	{
+		std::size_t writer = 0;
+		for (std::size_t chunk = 0; chunk < m_chunkSurvivors.size(); ++chunk)
+		{
+			const std::size_t begin = chunk * chunkSize;
+			if (writer != begin)
+				m_particles.moveRange(begin, m_chunkSurvivors[chunk], writer);
+			writer += m_chunkSurvivors[chunk];
+		}
+
+		m_particles.truncate(writer);
+	}
+
+	// Close the gaps the chunks left behind with survivors taken from behind the final particle count,
+	// only as many particles move as there are gaps
+	void ParticleSystem::fillChunkGaps()
+	{
+		std::size_t size = 0;
+		for (const std::size_t survivors : m_chunkSurvivors)
+			size += survivors;
+
+		std::size_t reader = size;
+		for (std::size_t chunk = 0; chunk * chunkSize < size; ++chunk)
+		{
+			const std::size_t end = std::min((chunk + 1U) * chunkSize, size);
+			for (std::size_t writer = chunk * chunkSize + m_chunkSurvivors[chunk]; writer < end; ++writer)
+			{
+				// Skip to the next chunk once the reader passes the survivors of its own one
+				while (reader % chunkSize >= m_chunkSurvivors[reader / chunkSize])
+					reader = (reader / chunkSize + 1U) * chunkSize;
+
+				m_particles.move(reader++, writer);
+			}
+		}
+
+		m_particles.truncate(size);
+	}
+
+	// Turn the particle states into spawn states or back when the evaluation changes
+	void ParticleSystem::switchEvaluation()
+	{
+		const bool closedForm = m_evaluationMode == EvaluationMode::ClosedForm && m_affectors.empty();
+		if (closedForm == m_closedForm)
+			return;
+
+		m_affectorSet.evaluate(m_particles, 0U, m_particles.size(), closedForm ? -1.f : 1.f);
+		m_closedForm = closedForm;
+	}
+
+	// Emitters fill their batch with the states at the current ages, in closed form those are turned into
+	// spawn states before the next batch or eviction can move the particles
+	void ParticleSystem::finishEmission()
+	{
+		if (m_emittedBatch == noBatch)
+			return;
+
+		if (m_closedForm)
+			m_affectorSet.evaluate(m_particles, m_emittedBatch, m_particles.size(), -1.f);
+		m_emittedBatch = noBatch;
+	}
+
+	// Make room for up to count new particles within the capacity, returns how many of them fit
+	std::size_t ParticleSystem::admitParticles(std::size_t count)
+	{
+		if (m_capacity == 0U || m_particles.size() + count <= m_capacity)
+			return count;
+
+		if (m_evictionPolicy == EvictionPolicy::DropNew)
+			return m_capacity - m_particles.size();
+
+		count = std::min(count, m_capacity);
+		evictParticles(m_particles.size() + count - m_capacity, m_evictionPolicy);
+		return count;
+	}
+
+	// Fit the particles Thor emitters sent while the system was full like one emitted batch, the latest ones
+	// win when there are more of them than the capacity
+	void ParticleSystem::admitPendingParticles()
+	{
+		if (m_pendingParticles.empty())
+			return;
+
+		const std::size_t count = admitParticles(m_pendingParticles.size());
+		const std::size_t first = m_particles.grow(count);
+		const std::size_t skipped = m_pendingParticles.size() - count;
+
+		for (std::size_t i = 0; i < count; ++i)
+			m_particles.set(first + i, m_pendingParticles[skipped + i]);
+
+		if (m_closedForm)
+			m_affectorSet.evaluate(m_particles, first, first + count, -1.f);
+		m_pendingParticles.clear();
+	}
+
+	// Kill the count particles the policy ranks first. Shrinking with DropNew kills the youngest ones
+	void ParticleSystem::evictParticles(std::size_t count, EvictionPolicy policy)
+	{
+		const std::size_t size = m_particles.size();
+		float* passedLifetime = m_particles.passedLifetime.data();
+		const float* totalLifetime = m_particles.totalLifetime.data();
+
+		if (count >= size)
+		{
+			m_particles.truncate(0U);
+			return;
+		}
+
+		m_evictionKeys.resize(size);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			if (policy == EvictionPolicy::KillOldest)
+				m_evictionKeys[i] = -passedLifetime[i];
+			else if (policy == EvictionPolicy::KillNearestToDeath)
+				m_evictionKeys[i] = totalLifetime[i] - passedLifetime[i];
+			else
+				m_evictionKeys[i] = passedLifetime[i];
+		}
+
+		// The key of the last victim, particles that tie with it are taken in index order
+		m_evictionOrder.assign(m_evictionKeys.begin(), m_evictionKeys.end());
+		std::nth_element(m_evictionOrder.begin(), m_evictionOrder.begin() + (count - 1U), m_evictionOrder.end());
+		const float threshold = m_evictionOrder[count - 1U];
+
+		std::size_t ties = count;
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			if (m_evictionKeys[i] < threshold)
+				--ties;
+		}
+
+		// Victims are marked dead and compacted like particles whose lifetime ran out
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			if (m_evictionKeys[i] < threshold)
+				passedLifetime[i] = totalLifetime[i];
+			else if (m_evictionKeys[i] == threshold && ties > 0U)
+			{
+				passedLifetime[i] = totalLifetime[i];
+				--ties;
+			}
+		}
+
+		m_particles.truncate(m_removalMode == RemovalMode::Stable ? removeDeadParticles(0U, size) : swapDeadParticles(0U, size));
+	}
+
+	// Gather the connected built-in affectors, so each chunk dispatches on their kinds once. Copying them
+	// allocates for gradients, so the set is only rebuilt after affectors were added or removed
+	void ParticleSystem::collectBuiltinAffectors()
+	{
+		if (!m_builtinAffectors.modified)
+			return;
+
+		m_builtinAffectors.modified = false;
+		m_affectorSet.clear();
+
+		for (const auto & affector : m_builtinAffectors)
+			m_affectorSet.add(affector.function);
+	}
+
+	void ParticleSystem::applyCustomAffectors(sf::Time dt)
+	{
+		if (m_affectors.empty())
+			return;
+
+		for (std::size_t i = 0; i < m_particles.size(); ++i)
+		{
+			Particle particle = m_particles.get(i);
+
+			for (auto & affector : m_affectors)
+				affector.function(particle, dt);
+
+			m_particles.set(i, particle);
+		}
+	}
+
+	// Quad centered around the origin that covers the whole texture
+	void ParticleSystem::computeQuad() const
+	{
+		m_quadSize = m_texture->getSize();
+		const sf::Vector2f size(m_quadSize);
+
+		m_quad[0].texCoords = sf::Vector2f(0.f, 0.f);
+		m_quad[1].texCoords = sf::Vector2f(size.x, 0.f);
+		m_quad[2].texCoords = sf::Vector2f(size.x, size.y);
+		m_quad[3].texCoords = sf::Vector2f(0.f, size.y);
+
+		m_quad[0].position = sf::Vector2f(-size.x, -size.y) / 2.f;
+		m_quad[1].position = sf::Vector2f(size.x, -size.y) / 2.f;
+		m_quad[2].position = sf::Vector2f(size.x, size.y) / 2.f;
+		m_quad[3].position = sf::Vector2f(-size.x, size.y) / 2.f;
+	}
+
+	// Interpolation draws position and rotation between the last two fixed steps, by the fraction of a step
+	// the accumulator holds. Without it the previous state is the current one and the blend changes nothing
+	void ParticleSystem::computeVertices(const ParticleStore & particles, bool interpolate, sf::Vertex * vertices) const
+	{
+		const float degToRad = 3.141592654f / 180.f;
+		const std::size_t count = particles.size();
+		const float alpha = interpolate ? m_accumulator / m_timestep : 1.f;
+		const float* previousX = interpolate ? particles.previousPositionX.data() : particles.positionX.data();
+		const float* previousY = interpolate ? particles.previousPositionY.data() : particles.positionY.data();
+		const float* previousRotation = interpolate ? particles.previousRotation.data() : particles.rotation.data();
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			// Scale, rotate and translate the texture quad
+			const float angle = (previousRotation[i] + (particles.rotation[i] - previousRotation[i]) * alpha) * degToRad;
+			const float cosine = std::cos(angle);
+			const float sine = std::sin(angle);
+			const float scaleX = particles.scaleX[i];
+			const float scaleY = particles.scaleY[i];
+			const float positionX = previousX[i] + (particles.positionX[i] - previousX[i]) * alpha;
+			const float positionY = previousY[i] + (particles.positionY[i] - previousY[i]) * alpha;
+
+			for (std::size_t corner = 0; corner < 4U; ++corner)
+			{
+				const sf::Vector2f local(m_quad[corner].position.x * scaleX, m_quad[corner].position.y * scaleY);
+				sf::Vertex & vertex = vertices[i * 4U + corner];
+				vertex.position.x = positionX + cosine * local.x - sine * local.y;
+				vertex.position.y = positionY + sine * local.x + cosine * local.y;
+				vertex.texCoords = m_quad[corner].texCoords;
+				vertex.color = particles.color[i];
+			}
+		}
+	}
+}
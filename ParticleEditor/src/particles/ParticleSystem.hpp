@@ -0,0 +1,212 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <particles/Affectors.hpp>
+#include <particles/EmissionInterface.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <Thor/Input/Connection.hpp>
+#include <array>
+#include <functional>
+#include <memory>
+
+namespace sf
+{
+	class Texture;
+}
+
+namespace px
+{
+	class ThreadPool;
+
+	// How dead particles are removed. Stable keeps the draw order of the survivors, which matters for
+	// alpha blended and opaque effects. SwapAndPop fills each hole with a particle from the back and
+	// only moves as many particles as died
+	enum class RemovalMode
+	{
+		Stable,
+		SwapAndPop
+	};
+
+	// What a system at its capacity does with new particles. DropNew discards them, the other policies
+	// kill as many existing particles as needed to fit them
+	enum class EvictionPolicy
+	{
+		DropNew,
+		KillOldest,
+		KillNearestToDeath
+	};
+
+	// How particle states advance. Integrated steps every particle through every frame. ClosedForm keeps
+	// the spawn states and evaluates the built-in affectors over each particle's age when drawing,
+	// so an update only ages the particles. It falls back to Integrated while custom affectors are attached
+	enum class EvaluationMode
+	{
+		Integrated,
+		ClosedForm
+	};
+
+	// Particle system that keeps its particles in a px-owned structure-of-arrays store.
+	// Emitters fill whole batches of particles, Thor emitters still work one particle at a time.
+	// The built-in affectors are stored by kind in a variant and applied a whole batch at a time,
+	// custom affectors operate on px::Particle and run afterwards one particle at a time.
+	// A system can be moved, the connections of its affectors and emitters move along with it
+	class ParticleSystem : public sf::Drawable, private EmissionInterface
+	{
+	public:
+		using Affector = std::function<void(Particle &, sf::Time)>;
+		using Emitter = std::function<void(EmissionInterface &, sf::Time)>;
+
+	public:
+		ParticleSystem();
+		ParticleSystem(const ParticleSystem &) = delete;
+		ParticleSystem(ParticleSystem && other);
+		~ParticleSystem() = default;
+
+		ParticleSystem & operator=(const ParticleSystem &) = delete;
+		ParticleSystem & operator=(ParticleSystem && other);
+
+	public:
+		// The texture must remain valid as long as the system uses it. The quads follow its size, a texture
+		// without pixels draws nothing
+		void setTexture(const sf::Texture & texture);
+
+		// A time until removal of zero keeps the affector or emitter until it is disconnected
+		thor::Connection addAffector(const ForceAffector & affector, sf::Time timeUntilRemoval = sf::Time::Zero);
+		thor::Connection addAffector(const TorqueAffector & affector, sf::Time timeUntilRemoval = sf::Time::Zero);
+		thor::Connection addAffector(const FadeAffector & affector, sf::Time timeUntilRemoval = sf::Time::Zero);
+		thor::Connection addAffector(const ScaleAffector & affector, sf::Time timeUntilRemoval = sf::Time::Zero);
+		thor::Connection addAffector(const ColorAffector & affector, sf::Time timeUntilRemoval = sf::Time::Zero);
+		thor::Connection addAffector(Affector affector, sf::Time timeUntilRemoval = sf::Time::Zero);
+		thor::Connection addEmitter(Emitter emitter, sf::Time timeUntilRemoval = sf::Time::Zero);
+		void clearAffectors();
+		void clearEmitters();
+		void clearParticles();
+
+		// Spread integration, built-in affectors and dead particle removal over the workers of pool.
+		// Emitters and custom affectors still run on the calling thread. nullptr updates serially
+		void setThreadPool(ThreadPool * pool);
+		void setRemovalMode(RemovalMode mode);
+
+		// Preallocate room for capacity particles and never hold more than that, zero removes the limit.
+		// Particles beyond a lowered capacity are evicted right away. Particles Thor emitters send to a full
+		// system are evicted for together like one batch, after all emitters of the update ran
+		void setCapacity(std::size_t capacity, EvictionPolicy policy = EvictionPolicy::DropNew);
+
+		// Simulate in steps of exactly step, the time update receives is accumulated and at most maxSubsteps
+		// steps run per update, time beyond that is dropped. Drawing trails the simulation by up to one step
+		// and interpolates positions and rotations between the last two steps. A step of zero simulates with
+		// the time update receives
+		void setFixedTimestep(sf::Time step, unsigned int maxSubsteps = 8U);
+		void setEvaluationMode(EvaluationMode mode);
+
+	public:
+		void update(sf::Time dt);
+
+		// Run the emitters and affectors for duration in coarse steps, without touching the fixed timestep
+		// accumulator or the vertices. Lets a looping effect start out in its steady state
+		void prewarm(sf::Time duration, sf::Time step = sf::seconds(0.1f));
+		std::size_t getParticleCount() const;
+
+		// The particles hold their spawn states while the system evaluates them in closed form
+		const ParticleStore & getParticles() const;
+
+		// The textured quads of the particles, four vertices each, for drawing several systems in one batch.
+		// Without a texture or with an empty one there are none
+		std::size_t getVertexCount() const;
+		void writeVertices(sf::Vertex * vertices) const;
+		const sf::Texture * getTexture() const;
+
+	private:
+		template <typename Function>
+		class EntryConnection;
+
+		// Affector or emitter + time until removal + id for removal
+		template <typename Function>
+		struct Entry
+		{
+			Entry(Function function, sf::Time timeUntilRemoval);
+
+			Function function;
+			sf::Time timeUntilRemoval;
+			unsigned int id;
+			std::shared_ptr<EntryConnection<Function>> tracker;
+		};
+
+		// Entries of one kind. Their connections refer to the container, so a moved container points them at itself
+		template <typename Function>
+		class EntryContainer : public std::vector<Entry<Function>>
+		{
+		public:
+			EntryContainer() = default;
+			EntryContainer(EntryContainer && other);
+			EntryContainer & operator=(EntryContainer && other);
+
+		public:
+			// Set whenever entries are added or removed, so what the system derives from them is only rebuilt then
+			bool modified = true;
+
+		private:
+			void retarget();
+		};
+
+		using Quad = std::array<sf::Vertex, 4>;
+		using BuiltinAffectorContainer = EntryContainer<BuiltinAffector>;
+		using AffectorContainer = EntryContainer<Affector>;
+		using EmitterContainer = EntryContainer<Emitter>;
+
+		template <typename Function>
+		thor::Connection add(EntryContainer<Function> & container, Function function, sf::Time timeUntilRemoval);
+
+	private:
+		virtual void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+		virtual void emitParticle(const thor::Particle & particle) override;
+		virtual std::size_t emitParticles(std::size_t count) override;
+		virtual ParticleStore & getParticleStore() override;
+
+		void simulate(sf::Time dt);
+		void switchEvaluation();
+		void finishEmission();
+		void collectBuiltinAffectors();
+		void updateChunk(std::size_t chunk, std::size_t begin, std::size_t end, float dt);
+		std::size_t removeDeadParticles(std::size_t begin, std::size_t end);
+		std::size_t swapDeadParticles(std::size_t begin, std::size_t end);
+		void mergeChunks();
+		void fillChunkGaps();
+		std::size_t admitParticles(std::size_t count);
+		void admitPendingParticles();
+		void evictParticles(std::size_t count, EvictionPolicy policy);
+		void applyCustomAffectors(sf::Time dt);
+		void computeQuad() const;
+		void computeVertices(const ParticleStore & particles, bool interpolate, sf::Vertex * vertices) const;
+
+	private:
+		ParticleStore m_particles;
+		BuiltinAffectorContainer m_builtinAffectors;
+		AffectorSet m_affectorSet;
+		AffectorContainer m_affectors;
+		EmitterContainer m_emitters;
+		ThreadPool* m_threadPool;
+		RemovalMode m_removalMode;
+		std::size_t m_capacity;
+		EvictionPolicy m_evictionPolicy;
+		std::vector<float> m_evictionKeys;
+		std::vector<float> m_evictionOrder;
+		std::vector<Particle> m_pendingParticles; // From Thor emitters while the system was full
+		sf::Time m_timestep;
+		sf::Time m_accumulator;
+		unsigned int m_maxSubsteps;
+		EvaluationMode m_evaluationMode;
+		bool m_closedForm;
+		std::size_t m_emittedBatch;
+		std::vector<std::size_t> m_chunkSurvivors;
+		const sf::Texture * m_texture;
+		mutable ParticleStore m_evaluated;
+		mutable std::vector<sf::Vertex> m_vertices;
+		mutable Quad m_quad;
+		mutable sf::Vector2u m_quadSize; // Texture size the quad was computed for
+		mutable bool m_needsVertexUpdate;
+	};
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Instruction set used by the vectorized kernels, picked at compile time. The x64
+// configurations of the project enable AVX2, Win32 ones use SSE2.
+// Define PX_NO_SIMD to force the scalar kernels
+////////////////////////////////////////////////////////////
+#if !defined(PX_NO_SIMD) && defined(__AVX2__)
+	#define PX_SIMD_AVX2
+	#include <immintrin.h>
+#elif !defined(PX_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define PX_SIMD_SSE2
+	#include <emmintrin.h>
+#endif
+
+#include <utils/FloatingPoint.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace px
+{
+	namespace simd
+	{
+		// Sine and cosine of x in radians after Cephes' sinf/cosf, accurate for |x| < 8192.
+		// The vector versions below perform the very same operations lane by lane and none of them
+		// is contracted into fused multiply-adds, so all of them return bit identical results
+		namespace constants
+		{
+			const float fourOverPi = 1.27323954473516f;
+			const float dp1 = 0.78515625f;
+			const float dp2 = 2.4187564849853515625e-4f;
+			const float dp3 = 3.77489497744594108e-8f;
+			const float cos0 = 2.443315711809948e-5f;
+			const float cos1 = -1.388731625493765e-3f;
+			const float cos2 = 4.166664568298827e-2f;
+			const float sin0 = -1.9515295891e-4f;
+			const float sin1 = 8.3321608736e-3f;
+			const float sin2 = -1.6666654611e-1f;
+		}
+
+		inline float flipSign(float value, std::uint32_t signBit)
+		{
+			std::uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			bits ^= signBit;
+			std::memcpy(&value, &bits, sizeof(bits));
+			return value;
+		}
+
+		inline void sincos(float x, float & sine, float & cosine)
+		{
+			using namespace constants;
+
+			std::uint32_t bits;
+			std::memcpy(&bits, &x, sizeof(bits));
+			std::uint32_t signSin = bits & 0x80000000U;
+			x = flipSign(x, signSin);
+
+			// Octant, rounded up to an even one, and the remainder within it
+			std::int32_t j = static_cast<std::int32_t>(x * fourOverPi);
+			j = (j + 1) & ~1;
+			const float y = static_cast<float>(j);
+			signSin ^= static_cast<std::uint32_t>(j & 4) << 29U;
+			const std::uint32_t signCos = static_cast<std::uint32_t>(~(j - 2) & 4) << 29U;
+			const bool swap = (j & 2) != 0;
+			x = ((x - y * dp1) - y * dp2) - y * dp3;
+
+			const float z = x * x;
+			float c = cos0;
+			c = c * z + cos1;
+			c = c * z + cos2;
+			c = c * z * z;
+			c = c - z * 0.5f;
+			c = c + 1.f;
+
+			float s = sin0;
+			s = s * z + sin1;
+			s = s * z + sin2;
+			s = s * z * x;
+			s = s + x;
+
+			sine = flipSign(swap ? c : s, signSin);
+			cosine = flipSign(swap ? s : c, signCos);
+		}
+
+#if defined(PX_SIMD_AVX2)
+
+		inline void sincos(__m256 x, __m256 & sine, __m256 & cosine)
+		{
+			using namespace constants;
+			const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(0x80000000U)));
+
+			__m256 signSin = _mm256_and_ps(x, signMask);
+			x = _mm256_andnot_ps(signMask, x);
+
+			__m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(fourOverPi)));
+			j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+			const __m256 y = _mm256_cvtepi32_ps(j);
+			signSin = _mm256_xor_ps(signSin, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29)));
+			const __m256 signCos = _mm256_castsi256_ps(_mm256_slli_epi32(
+				_mm256_andnot_si256(_mm256_sub_epi32(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+			const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(2)));
+			x = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(dp1))),
+				_mm256_mul_ps(y, _mm256_set1_ps(dp2))), _mm256_mul_ps(y, _mm256_set1_ps(dp3)));
+
+			const __m256 z = _mm256_mul_ps(x, x);
+			__m256 c = _mm256_set1_ps(cos0);
+			c = _mm256_add_ps(_mm256_mul_ps(c, z), _mm256_set1_ps(cos1));
+			c = _mm256_add_ps(_mm256_mul_ps(c, z), _mm256_set1_ps(cos2));
+			c = _mm256_mul_ps(_mm256_mul_ps(c, z), z);
+			c = _mm256_sub_ps(c, _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+			c = _mm256_add_ps(c, _mm256_set1_ps(1.f));
+
+			__m256 s = _mm256_set1_ps(sin0);
+			s = _mm256_add_ps(_mm256_mul_ps(s, z), _mm256_set1_ps(sin1));
+			s = _mm256_add_ps(_mm256_mul_ps(s, z), _mm256_set1_ps(sin2));
+			s = _mm256_mul_ps(_mm256_mul_ps(s, z), x);
+			s = _mm256_add_ps(s, x);
+
+			sine = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), signSin);
+			cosine = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), signCos);
+		}
+
+#elif defined(PX_SIMD_SSE2)
+
+		inline __m128 select(__m128 mask, __m128 whenSet, __m128 whenClear)
+		{
+			return _mm_or_ps(_mm_and_ps(mask, whenSet), _mm_andnot_ps(mask, whenClear));
+		}
+
+		inline void sincos(__m128 x, __m128 & sine, __m128 & cosine)
+		{
+			using namespace constants;
+			const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000U)));
+
+			__m128 signSin = _mm_and_ps(x, signMask);
+			x = _mm_andnot_ps(signMask, x);
+
+			__m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(fourOverPi)));
+			j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+			const __m128 y = _mm_cvtepi32_ps(j);
+			signSin = _mm_xor_ps(signSin, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29)));
+			const __m128 signCos = _mm_castsi128_ps(_mm_slli_epi32(
+				_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+			const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_set1_epi32(2)));
+			x = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(dp1))),
+				_mm_mul_ps(y, _mm_set1_ps(dp2))), _mm_mul_ps(y, _mm_set1_ps(dp3)));
+
+			const __m128 z = _mm_mul_ps(x, x);
+			__m128 c = _mm_set1_ps(cos0);
+			c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(cos1));
+			c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(cos2));
+			c = _mm_mul_ps(_mm_mul_ps(c, z), z);
+			c = _mm_sub_ps(c, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+			c = _mm_add_ps(c, _mm_set1_ps(1.f));
+
+			__m128 s = _mm_set1_ps(sin0);
+			s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(sin1));
+			s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(sin2));
+			s = _mm_mul_ps(_mm_mul_ps(s, z), x);
+			s = _mm_add_ps(s, x);
+
+			sine = _mm_xor_ps(select(swap, c, s), signSin);
+			cosine = _mm_xor_ps(select(swap, s, c), signCos);
+		}
+
+#endif
+	}
+}
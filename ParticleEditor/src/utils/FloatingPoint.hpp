@@ -0,0 +1,14 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Multiply and add stay separate operations in every file that includes this header. A fused
+// multiply-add rounds once instead of twice, so contracting would give FMA builds other results
+// than the scalar and the SSE2 kernels. Simulation code includes it so every build steps the same
+////////////////////////////////////////////////////////////
+#if defined(_MSC_VER)
+	#pragma fp_contract(off)
+#elif defined(__clang__)
+	#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+	#pragma GCC optimize("fp-contract=off")
+#endif
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace px
+{
+#ifdef _WIN32
+	MappedFile::MappedFile() : m_data(nullptr), m_size(0U), m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr)
+	{
+	}
+#else
+	MappedFile::MappedFile() : m_data(nullptr), m_size(0U)
+	{
+	}
+#endif
+
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+#ifdef _WIN32
+	bool MappedFile::open(const std::string & filePath)
+	{
+		close();
+
+		m_file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		LARGE_INTEGER size;
+		if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+		{
+			close();
+			return false;
+		}
+
+		m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+		m_data = m_mapping ? static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+		if (!m_data)
+		{
+			close();
+			return false;
+		}
+
+		m_size = static_cast<std::size_t>(size.QuadPart);
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		if (m_data)
+			UnmapViewOfFile(m_data);
+		if (m_mapping)
+			CloseHandle(m_mapping);
+		if (m_file != INVALID_HANDLE_VALUE)
+			CloseHandle(m_file);
+
+		m_data = nullptr;
+		m_size = 0U;
+		m_mapping = nullptr;
+		m_file = INVALID_HANDLE_VALUE;
+	}
+#else
+	bool MappedFile::open(const std::string & filePath)
+	{
+		close();
+
+		const int file = ::open(filePath.c_str(), O_RDONLY);
+		if (file < 0)
+			return false;
+
+		// The mapping keeps the file alive, so the descriptor is not needed afterwards
+		struct stat status;
+		if (fstat(file, &status) == 0 && status.st_size > 0)
+		{
+			void * data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+			if (data != MAP_FAILED)
+			{
+				m_data = static_cast<const char*>(data);
+				m_size = static_cast<std::size_t>(status.st_size);
+			}
+		}
+
+		::close(file);
+		return m_data != nullptr;
+	}
+
+	void MappedFile::close()
+	{
+		if (m_data)
+			munmap(const_cast<char*>(m_data), m_size);
+
+		m_data = nullptr;
+		m_size = 0U;
+	}
+#endif
+
+	const char * MappedFile::getData() const
+	{
+		return m_data;
+	}
+
+	std::size_t MappedFile::getSize() const
+	{
+		return m_size;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <string>
+
+namespace px
+{
+	// Read-only memory mapping of a whole file, the pages are read in by the OS as they are touched
+	class MappedFile : private sf::NonCopyable
+	{
+	public:
+		MappedFile();
+		~MappedFile();
+
+	public:
+		// Fails for missing and empty files, a previous mapping is closed either way
+		bool open(const std::string & filePath);
+		void close();
+
+		const char * getData() const;
+		std::size_t getSize() const;
+
+	private:
+		const char * m_data;
+		std::size_t m_size;
+#ifdef _WIN32
+		void * m_file;
+		void * m_mapping;
+#endif
+	};
+}
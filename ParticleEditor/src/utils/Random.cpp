@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Random.hpp"
+#include <utils/FloatingPoint.hpp>
+#include <atomic>
+#include <chrono>
+
+namespace px
+{
+	namespace
+	{
+		// 2^-24, maps the upper 24 bits of a draw onto [0, 1)
+		const float unitScale = 1.f / 16777216.f;
+	}
+
+	Random::Random(std::uint64_t seed, std::uint64_t stream) : m_state(0U), m_increment(0U)
+	{
+		this->seed(seed, stream);
+	}
+
+	void Random::seed(std::uint64_t seed, std::uint64_t stream)
+	{
+		m_state = 0U;
+		m_increment = (stream << 1U) | 1U;
+		next();
+		m_state += seed;
+		next();
+	}
+
+	std::uint32_t Random::next()
+	{
+		const std::uint64_t old = m_state;
+		m_state = old * 6364136223846793005ULL + m_increment;
+
+		const std::uint32_t xorShifted = static_cast<std::uint32_t>(((old >> 18U) ^ old) >> 27U);
+		const std::uint32_t rotation = static_cast<std::uint32_t>(old >> 59U);
+		return (xorShifted >> rotation) | (xorShifted << ((32U - rotation) & 31U));
+	}
+
+	float Random::uniform()
+	{
+		return static_cast<float>(next() >> 8U) * unitScale;
+	}
+
+	float Random::uniform(float min, float max)
+	{
+		return min + (max - min) * uniform();
+	}
+
+	float Random::deviation(float middle, float deviation)
+	{
+		return uniform(middle - deviation, middle + deviation);
+	}
+
+	void Random::fill(float * out, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			out[i] = static_cast<float>(next() >> 8U) * unitScale;
+	}
+
+	void Random::fill(float * out, std::size_t count, float min, float max)
+	{
+		const float range = max - min;
+		for (std::size_t i = 0; i < count; ++i)
+			out[i] = min + range * (static_cast<float>(next() >> 8U) * unitScale);
+	}
+
+	std::uint64_t makeSeed()
+	{
+		static std::atomic<std::uint64_t> counter(0U);
+		const auto now = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+		return now ^ (++counter * 0x9e3779b97f4a7c15ULL);
+	}
+}
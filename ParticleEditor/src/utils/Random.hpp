@@ -0,0 +1,38 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+
+namespace px
+{
+	// PCG32 generator. Every system or thread owns its own instance, so streams never
+	// have to be shared between threads and every effect can be seeded on its own
+	class Random
+	{
+	public:
+		explicit Random(std::uint64_t seed = 0x853c49e6748fea9bULL, std::uint64_t stream = 0xda3e39cb94b95bdbULL);
+
+	public:
+		void seed(std::uint64_t seed, std::uint64_t stream = 0xda3e39cb94b95bdbULL);
+		std::uint32_t next();
+
+		// Uniform in [0, 1), [min, max) and [middle - deviation, middle + deviation)
+		float uniform();
+		float uniform(float min, float max);
+		float deviation(float middle, float deviation);
+
+		// Bulk versions, fill count floats at out
+		void fill(float * out, std::size_t count);
+		void fill(float * out, std::size_t count, float min, float max);
+
+	private:
+		std::uint64_t m_state;
+		std::uint64_t m_increment;
+	};
+
+	// Seed for a new stream when the caller has none, differs on every call
+	std::uint64_t makeSeed();
+}
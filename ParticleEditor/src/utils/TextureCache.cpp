@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "TextureCache.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace px
+{
+	namespace
+	{
+		// What a texture shows until its image is decoded, a single white pixel the particle colors tint
+		const sf::Image & getPlaceholder()
+		{
+			static const sf::Image placeholder = []
+			{
+				sf::Image image;
+				image.create(1U, 1U, sf::Color::White);
+				return image;
+			}();
+
+			return placeholder;
+		}
+	}
+
+	TextureCache::TextureCache(std::size_t capacity) : m_stopDecoding(false), m_capacity(capacity), m_asyncDecode(false)
+	{
+	}
+
+	TextureCache::~TextureCache()
+	{
+		if (!m_decodeThread.joinable())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_jobMutex);
+			m_stopDecoding = true;
+		}
+
+		m_jobAdded.notify_one();
+		m_decodeThread.join();
+	}
+
+	TextureCache & TextureCache::getDefault()
+	{
+		static TextureCache cache;
+		return cache;
+	}
+
+	std::shared_ptr<sf::Texture> TextureCache::acquire(const std::string & filePath)
+	{
+		return acquire(filePath, nullptr, 0U);
+	}
+
+	std::shared_ptr<sf::Texture> TextureCache::acquire(const std::string & filePath, const char * data, std::size_t size)
+	{
+		auto found = m_textures.find(filePath);
+		if (found != m_textures.end())
+		{
+			m_recentlyUsed.splice(m_recentlyUsed.begin(), m_recentlyUsed, found->second.recent);
+			const std::shared_ptr<sf::Texture> texture = found->second.texture;
+
+			auto pending = std::find_if(m_pending.begin(), m_pending.end(), [&texture](const PendingDecode & p)
+			{
+				return p.texture == texture;
+			});
+
+			if (!m_asyncDecode && pending != m_pending.end())
+			{
+				upload(*pending);
+				m_pending.erase(pending);
+			}
+
+			return texture;
+		}
+
+		auto texture = std::make_shared<sf::Texture>();
+		if (m_asyncDecode)
+		{
+			// Only the decode leaves the calling thread, the upload needs the thread that draws. Data in
+			// memory is copied, the caller may release it before the decode is done
+			DecodeJob job{ filePath, std::vector<char>(data, data + size), data != nullptr, std::promise<sf::Image>() };
+			auto image = job.image.get_future();
+			{
+				std::lock_guard<std::mutex> lock(m_jobMutex);
+				m_jobs.push_back(std::move(job));
+			}
+
+			if (!m_decodeThread.joinable())
+				m_decodeThread = std::thread(&TextureCache::decodeJobs, this);
+			m_jobAdded.notify_one();
+
+			texture->loadFromImage(getPlaceholder());
+			m_pending.push_back(PendingDecode{ filePath, texture, std::move(image) });
+		}
+		else if (!(data ? texture->loadFromMemory(data, size) : texture->loadFromFile(filePath)))
+			return texture;
+
+		m_recentlyUsed.push_front(filePath);
+		m_textures.emplace(filePath, Entry{ texture, m_recentlyUsed.begin() });
+		evict(m_capacity);
+		return texture;
+	}
+
+	void TextureCache::setAsyncDecode(bool enabled)
+	{
+		m_asyncDecode = enabled;
+	}
+
+	std::size_t TextureCache::uploadDecoded()
+	{
+		const std::size_t pendingCount = m_pending.size();
+
+		m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(), [this](PendingDecode & pending)
+		{
+			if (pending.image.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+				return false;
+
+			upload(pending);
+			return true;
+		}), m_pending.end());
+
+		return pendingCount - m_pending.size();
+	}
+
+	bool TextureCache::isDecoding() const
+	{
+		return !m_pending.empty();
+	}
+
+	void TextureCache::setCapacity(std::size_t capacity)
+	{
+		m_capacity = capacity;
+		evict(m_capacity);
+	}
+
+	void TextureCache::clear()
+	{
+		evict(0U);
+	}
+
+	std::size_t TextureCache::getTextureCount() const
+	{
+		return m_textures.size();
+	}
+
+	// Walk from the least recently used texture and unload unused ones until at most capacity are left
+	void TextureCache::evict(std::size_t capacity)
+	{
+		std::size_t unused = 0;
+		for (const auto & entry : m_textures)
+			unused += entry.second.texture.use_count() == 1 ? 1U : 0U;
+
+		for (auto it = m_recentlyUsed.end(); unused > capacity && it != m_recentlyUsed.begin();)
+		{
+			--it;
+			auto found = m_textures.find(*it);
+			if (found->second.texture.use_count() != 1)
+				continue;
+
+			m_textures.erase(found);
+			it = m_recentlyUsed.erase(it);
+			--unused;
+		}
+	}
+
+	// Runs on the decode thread until the cache is destroyed
+	void TextureCache::decodeJobs()
+	{
+		std::unique_lock<std::mutex> lock(m_jobMutex);
+
+		for (;;)
+		{
+			m_jobAdded.wait(lock, [this] { return m_stopDecoding || !m_jobs.empty(); });
+			if (m_stopDecoding)
+				return;
+
+			DecodeJob job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+			lock.unlock();
+
+			sf::Image image;
+			job.fromMemory ? image.loadFromMemory(job.contents.data(), job.contents.size()) : image.loadFromFile(job.filePath);
+			job.image.set_value(std::move(image));
+			lock.lock();
+		}
+	}
+
+	// The image replaces the placeholder in the same texture, so whoever holds it draws the image from now on.
+	// A failed decode empties the texture and drops it from the cache, so the next acquire tries again
+	void TextureCache::upload(PendingDecode & pending)
+	{
+		const sf::Image image = pending.image.get();
+		if (image.getSize().x > 0U && image.getSize().y > 0U && pending.texture->loadFromImage(image))
+			return;
+
+		*pending.texture = sf::Texture();
+		auto found = m_textures.find(pending.filePath);
+		if (found != m_textures.end() && found->second.texture == pending.texture)
+		{
+			m_recentlyUsed.erase(found->second.recent);
+			m_textures.erase(found);
+		}
+	}
+}
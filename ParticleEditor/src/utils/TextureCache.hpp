@@ -0,0 +1,103 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace px
+{
+	// Decodes every texture file once and hands out shared handles to it. A texture stays loaded while any
+	// handle to it is alive. Of the textures nobody holds, the cache keeps the most recently used ones up to
+	// its capacity, so an effect that is spawned again soon does not decode its texture again
+	class TextureCache : private sf::NonCopyable
+	{
+	public:
+		explicit TextureCache(std::size_t capacity = 16U);
+
+		// Stops the decode thread after the image it is working on, textures still waiting keep the placeholder
+		~TextureCache();
+
+	public:
+		// The cache used by px::EffectDefinition and the editor unless they are given another one
+		static TextureCache & getDefault();
+
+	public:
+		// A file that fails to load yields an empty texture, which is not cached. Without async decoding
+		// a texture that is still decoding is completed before it is returned
+		std::shared_ptr<sf::Texture> acquire(const std::string & filePath);
+
+		// Same as above, but a texture that is not cached yet is decoded from data, the contents of the file
+		// held in memory. The data is only needed during the call
+		std::shared_ptr<sf::Texture> acquire(const std::string & filePath, const char * data, std::size_t size);
+
+		// Decode new files to an sf::Image on a background thread, which the cache starts on first use and which
+		// decodes one file after another. acquire then returns at once a texture holding a 1x1 white placeholder,
+		// and uploadDecoded loads the image into that same texture once it is ready. Disabled by default
+		void setAsyncDecode(bool enabled);
+
+		// Upload the images decoded so far, on the thread that draws. Returns how many textures were completed
+		std::size_t uploadDecoded();
+		bool isDecoding() const;
+
+		// Maximum number of unused textures that stay loaded. The least recently used ones beyond it are
+		// unloaded when the capacity is set and whenever a new texture is loaded
+		void setCapacity(std::size_t capacity);
+
+		// Unload every texture nobody holds
+		void clear();
+		std::size_t getTextureCount() const;
+
+	private:
+		struct Entry
+		{
+			std::shared_ptr<sf::Texture> texture;
+			std::list<std::string>::iterator recent;
+		};
+
+		// Texture waiting for its image, an image without pixels means decoding failed
+		struct PendingDecode
+		{
+			std::string filePath;
+			std::shared_ptr<sf::Texture> texture;
+			std::future<sf::Image> image;
+		};
+
+		// Image the decode thread reads from the file, or from contents for files held in memory
+		struct DecodeJob
+		{
+			std::string filePath;
+			std::vector<char> contents;
+			bool fromMemory;
+			std::promise<sf::Image> image;
+		};
+
+		void evict(std::size_t capacity);
+		void upload(PendingDecode & pending);
+		void decodeJobs();
+
+	private:
+		std::unordered_map<std::string, Entry> m_textures;
+		std::list<std::string> m_recentlyUsed; // Most recently used first
+		std::vector<PendingDecode> m_pending;
+		std::deque<DecodeJob> m_jobs; // Shared with the decode thread, guarded by m_jobMutex
+		std::mutex m_jobMutex;
+		std::condition_variable m_jobAdded;
+		std::thread m_decodeThread;
+		bool m_stopDecoding;
+		std::size_t m_capacity;
+		bool m_asyncDecode;
+	};
+}
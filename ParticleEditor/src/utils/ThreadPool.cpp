@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace px
+{
+	ThreadPool::ThreadPool(std::size_t workerCount) : m_running(true)
+	{
+		for (std::size_t i = 0; i < workerCount; ++i)
+			m_workers.emplace_back(&ThreadPool::work, this);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_running = false;
+		}
+
+		m_wake.notify_all();
+		for (auto & worker : m_workers)
+			worker.join();
+	}
+
+	std::size_t ThreadPool::getWorkerCount() const
+	{
+		return m_workers.size();
+	}
+
+	void ThreadPool::parallelFor(std::size_t count, std::size_t grain, const Task & task)
+	{
+		if (count == 0)
+			return;
+
+		grain = std::max<std::size_t>(grain, 1U);
+		const std::size_t chunks = (count + grain - 1U) / grain;
+
+		// Not worth a hand-off
+		if (chunks == 1U || m_workers.empty())
+		{
+			task(0U, count);
+			return;
+		}
+
+		std::atomic<std::size_t> remaining(chunks);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (std::size_t begin = 0; begin < count; begin += grain)
+				m_chunks.push_back({ &task, begin, std::min(begin + grain, count), &remaining });
+		}
+		m_wake.notify_all();
+
+		// Help out until all of our chunks are done
+		while (remaining.load(std::memory_order_acquire) != 0U)
+		{
+			if (!runPending())
+				std::this_thread::yield();
+		}
+	}
+
+	void ThreadPool::work()
+	{
+		while (true)
+		{
+			Chunk chunk;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [this] { return !m_running || !m_chunks.empty(); });
+
+				if (m_chunks.empty())
+					return;
+
+				chunk = m_chunks.front();
+				m_chunks.pop_front();
+			}
+
+			run(chunk);
+		}
+	}
+
+	bool ThreadPool::runPending()
+	{
+		Chunk chunk;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_chunks.empty())
+				return false;
+
+			chunk = m_chunks.front();
+			m_chunks.pop_front();
+		}
+
+		run(chunk);
+		return true;
+	}
+
+	void ThreadPool::run(const Chunk & chunk)
+	{
+		(*chunk.task)(chunk.begin, chunk.end);
+		chunk.remaining->fetch_sub(1U, std::memory_order_release);
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace px
+{
+	class ThreadPool : private sf::NonCopyable
+	{
+	public:
+		using Task = std::function<void(std::size_t begin, std::size_t end)>;
+
+	public:
+		// Spawns one worker less than the number of hardware threads, the caller is the last one
+		explicit ThreadPool(std::size_t workerCount = std::max(std::thread::hardware_concurrency(), 1U) - 1U);
+		~ThreadPool();
+
+	public:
+		std::size_t getWorkerCount() const;
+
+		// Run task over [0, count) in chunks of grain elements and block until every chunk is done.
+		// The calling thread works on the chunks too, so nested calls from a task are fine
+		void parallelFor(std::size_t count, std::size_t grain, const Task & task);
+
+	private:
+		struct Chunk
+		{
+			const Task* task;
+			std::size_t begin;
+			std::size_t end;
+			std::atomic<std::size_t>* remaining;
+		};
+
+	private:
+		void work();
+		bool runPending();
+		static void run(const Chunk & chunk);
+
+	private:
+		std::vector<std::thread> m_workers;
+		std::deque<Chunk> m_chunks;
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		bool m_running;
+	};
+}